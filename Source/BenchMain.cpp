@@ -0,0 +1,710 @@
+/*
+  ==============================================================================
+
+    BenchMain.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    Offline measurements for the DSP building blocks (and the visualizer embers).
+    Run: AbyssalGazeBench > bench_output.txt
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DelayMemory.h"
+#include "GrainEngine.h"
+#include "DSPKernels.h"
+#include "ModulationMatrix.h"
+#include "RateReducer.h"
+#include "EmberField.h"
+#include "SubBlockAutomation.h"
+#include "VoidReverb.h"
+
+#include <cstdio>
+
+namespace
+{
+    constexpr double benchSampleRate = 48000.0;
+    constexpr int benchBlockSize = 64;
+    constexpr double delaySeconds = 30.0; // AbyssalGazeNewAudioProcessor::maxDelaySeconds
+
+    const char* formatNames[] = { "32-bit Float", "16-bit Half", "16-bit Int", "64-bit Double" };
+
+    // RMS error (dBFS) of a sine at levelDb after a trip through the memory
+    float measureNoiseFloor (DelayMemory& memory, float levelDb)
+    {
+        const int numSamples = (int) benchSampleRate;
+        std::vector<float> in ((size_t) numSamples), out ((size_t) numSamples);
+
+        auto gain = juce::Decibels::decibelsToGain (levelDb);
+        for (int i = 0; i < numSamples; ++i)
+            in[(size_t) i] = gain * std::sin (juce::MathConstants<float>::twoPi * 997.0f * (float) i / (float) benchSampleRate);
+
+        memory.write (0, 0, in.data(), numSamples);
+        memory.read (0, 0, out.data(), numSamples);
+
+        double errorSquared = 0.0;
+        for (int i = 0; i < numSamples; ++i)
+            errorSquared += juce::square ((double) in[(size_t) i] - (double) out[(size_t) i]);
+
+        auto errorRms = std::sqrt (errorSquared / numSamples);
+        return errorRms > 0.0 ? juce::Decibels::gainToDecibels ((float) errorRms, -200.0f) : -200.0f;
+    }
+
+    // Nanoseconds per sample for one read + one write, in segment-sized blocks
+    double measureReadWrite (DelayMemory& memory)
+    {
+        const int numBlocks = (int) (60.0 * benchSampleRate) / benchBlockSize;
+        const int delaySamples = (int) (0.5 * benchSampleRate);
+
+        juce::Random random (1);
+        std::vector<float> block (benchBlockSize), delayed (benchBlockSize);
+        for (auto& s : block)
+            s = random.nextFloat() * 2.0f - 1.0f;
+
+        int position = 0;
+        float checksum = 0.0f;
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < memory.getNumChannels(); ++ch)
+            {
+                memory.read (ch, position - delaySamples, delayed.data(), benchBlockSize);
+                memory.write (ch, position, block.data(), benchBlockSize);
+                checksum += delayed[0];
+            }
+
+            position = memory.wrap (position + benchBlockSize);
+        }
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+        juce::ignoreUnused (checksum);
+
+        return seconds * 1.0e9 / ((double) numBlocks * benchBlockSize * memory.getNumChannels());
+    }
+
+    void benchDelayMemory()
+    {
+        std::printf ("== Whispers delay memory: %.0fs stereo @ %.0fHz ==\n", delaySeconds, benchSampleRate);
+        std::printf ("%-14s %12s %14s %17s %17s\n", "Format", "Memory (MB)", "R+W (ns/smp)", "Floor -6dB sine", "Floor -60dB sine");
+
+        for (int f = 0; f < DelayMemory::numFormats; ++f)
+        {
+            DelayMemory memory;
+            memory.prepare (2, (int) (delaySeconds * benchSampleRate) + 1, (DelayMemory::Format) f);
+
+            auto megabytes = (double) memory.getMemoryBytes() / (1024.0 * 1024.0);
+            auto nanoseconds = measureReadWrite (memory);
+            auto floorLoud  = measureNoiseFloor (memory, -6.0f);
+            auto floorQuiet = measureNoiseFloor (memory, -60.0f);
+
+            std::printf ("%-14s %12.1f %14.3f %12.1f dBFS %12.1f dBFS\n",
+                         formatNames[f], megabytes, nanoseconds, floorLoud, floorQuiet);
+        }
+
+        std::printf ("\n");
+    }
+
+    // Realtime load of the granular engine for increasing grain counts
+    void benchGrainEngine()
+    {
+        std::printf ("== Granular Whispers: 10s stereo @ %.0fHz, 16-bit Half memory ==\n", benchSampleRate);
+        std::printf ("%-10s %12s %12s %12s\n", "Density", "Avg grains", "Voice limit", "Realtime %");
+
+        const int numBlocks = (int) (10.0 * benchSampleRate) / benchBlockSize;
+        const int blocksPerHostBuffer = 512 / benchBlockSize;
+
+        for (auto density : { 200.0f, 600.0f, 1000.0f })
+        {
+            DelayMemory memory;
+            memory.prepare (2, (int) (delaySeconds * benchSampleRate) + 1, DelayMemory::half16);
+
+            GrainEngine engine;
+            engine.prepare (benchSampleRate, 2);
+            engine.setParameters (density, 0.5f, 7.0f, 0.8f, 2.0f);
+
+            std::vector<float> input (benchBlockSize), left (benchBlockSize), right (benchBlockSize);
+            float* out[2] = { left.data(), right.data() };
+
+            int position = 0;
+            double grainSum = 0.0;
+            auto start = juce::Time::getHighResolutionTicks();
+
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                for (int i = 0; i < benchBlockSize; ++i)
+                    input[(size_t) i] = std::sin (0.01f * (float) (b * benchBlockSize + i));
+
+                std::fill (left.begin(), left.end(), 0.0f);
+                std::fill (right.begin(), right.end(), 0.0f);
+                engine.process (memory, position, out, 2, benchBlockSize);
+
+                memory.write (0, position, input.data(), benchBlockSize);
+                memory.write (1, position, input.data(), benchBlockSize);
+                position = memory.wrap (position + benchBlockSize);
+
+                grainSum += engine.getNumActiveGrains();
+
+                if ((b + 1) % blocksPerHostBuffer == 0)
+                    engine.adaptVoices (512.0 / benchSampleRate);
+            }
+
+            auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+
+            std::printf ("%-10.0f %12.1f %12d %12.2f\n",
+                         density, grainSum / numBlocks, engine.getVoiceLimit(), 100.0 * seconds / 10.0);
+        }
+
+        std::printf ("\n");
+    }
+
+    //==============================================================================
+    // Cost of the modulation matrix per control interval, and how far its linear
+    // ramps stray from the exact LFO curve (the zipper / glitch risk of a coarse interval)
+    void benchModulationMatrix()
+    {
+        std::printf ("== Modulation matrix: 4 slots, 10s @ %.0fHz, LFO 1 at 20Hz ==\n", benchSampleRate);
+        std::printf ("%-10s %12s %12s %14s %16s\n", "Interval", "ns/smp", "Realtime %", "Max ramp error", "Max step/exact");
+
+        const int numSamples = (int) (10.0 * benchSampleRate);
+        const float lfoRate = 20.0f; // top of the LFO range: worst case for the ramps
+        const float depth = 1.0f;
+
+        // Pre-generated input peaks so only the matrix is timed
+        std::vector<float> peaks (1024);
+        juce::Random random (1);
+        for (auto& p : peaks)
+            p = random.nextFloat();
+
+        for (auto interval : { 16, 32, 64 })
+        {
+            ModulationMatrix matrix;
+            matrix.prepare (benchSampleRate);
+            matrix.setControlInterval (interval);
+            matrix.setLfoRate (0, lfoRate);
+            matrix.setLfoRate (1, 3.0f);
+            matrix.setAudioRate (ModulationMatrix::destDrown, true);
+            matrix.setSlot (0, ModulationMatrix::sourceLfo1, ModulationMatrix::destObscura, depth);
+            matrix.setSlot (1, ModulationMatrix::sourceLfo2, ModulationMatrix::destCorruption, 0.5f);
+            matrix.setSlot (2, ModulationMatrix::sourceEnvelope, ModulationMatrix::destVoid, 0.4f);
+            matrix.setSlot (3, ModulationMatrix::sourceLfo1, ModulationMatrix::destDrown, 0.2f);
+            matrix.reset();
+
+            const int numSegments = numSamples / interval;
+            float checksum = 0.0f;
+            auto start = juce::Time::getHighResolutionTicks();
+
+            for (int s = 0; s < numSegments; ++s)
+            {
+                matrix.advance (interval, peaks[(size_t) s % peaks.size()]);
+                checksum += matrix.getEndOffset (ModulationMatrix::destObscura);
+            }
+
+            auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+            juce::ignoreUnused (checksum);
+
+            // The ramp the chain actually applies to Obscura, sample by sample, against sin(phase)
+            matrix.reset();
+            const auto increment = juce::MathConstants<double>::twoPi * lfoRate / benchSampleRate;
+            double maxError = 0.0, maxStep = 0.0, maxExactStep = 0.0;
+            double previous = 0.0, previousExact = 0.0;
+
+            for (int s = 0; s < numSegments; ++s)
+            {
+                matrix.advance (interval, 0.0f);
+                const auto startOffset = matrix.getStartOffset (ModulationMatrix::destObscura);
+                const auto endOffset = matrix.getEndOffset (ModulationMatrix::destObscura);
+
+                for (int i = 1; i <= interval; ++i)
+                {
+                    const auto n = s * interval + i;
+                    const auto value = startOffset + (endOffset - startOffset) * (double) i / (double) interval;
+                    const auto exact = depth * std::sin (increment * n);
+
+                    maxError = juce::jmax (maxError, std::abs (value - exact));
+
+                    if (n > 1)
+                    {
+                        maxStep = juce::jmax (maxStep, std::abs (value - previous));
+                        maxExactStep = juce::jmax (maxExactStep, std::abs (exact - previousExact));
+                    }
+
+                    previous = value;
+                    previousExact = exact;
+                }
+            }
+
+            std::printf ("%-10d %12.3f %12.4f %14.5f %16.3f\n", interval,
+                         seconds * 1.0e9 / (numSegments * interval), 100.0 * seconds / 10.0,
+                         maxError, maxStep / juce::jmax (1.0e-12, maxExactStep));
+        }
+
+        std::printf ("\n");
+    }
+
+    // The envelope follower must track the same whether a 64-sample period arrives whole
+    // or split at automation events. Returns false on failure.
+    bool checkEnvelopeSplitting()
+    {
+        std::printf ("== Modulation envelope: whole vs. split 64-sample periods ==\n");
+
+        ModulationMatrix whole, split;
+
+        for (auto* matrix : { &whole, &split })
+        {
+            matrix->prepare (benchSampleRate);
+            matrix->setControlInterval (64);
+            matrix->setSlot (0, ModulationMatrix::sourceEnvelope, ModulationMatrix::destVoid, 1.0f);
+            matrix->reset();
+        }
+
+        juce::Random random (1);
+        double maxDifference = 0.0;
+
+        for (int period = 0; period < (int) benchSampleRate / 64; ++period)
+        {
+            // A step up then a long release, so both coefficients are exercised
+            const float peak = period < 200 ? 0.8f : 0.0f;
+            whole.advance (64, peak);
+
+            for (int done = 0; done < 64;)
+            {
+                const int num = juce::jmin (64 - done, 1 + random.nextInt (20));
+                split.advance (num, peak);
+                done += num;
+            }
+
+            maxDifference = juce::jmax (maxDifference, (double) std::abs (whole.getEndOffset (ModulationMatrix::destVoid)
+                                                                          - split.getEndOffset (ModulationMatrix::destVoid)));
+        }
+
+        const bool passed = maxDifference < 1.0e-4;
+        std::printf ("Max difference: %.2e: %s\n\n", maxDifference, passed ? "ok" : "FAILED");
+        return passed;
+    }
+
+    //==============================================================================
+    // Runs one block through SubBlockAutomation the way processChain does (32-sample
+    // control interval) and returns the value the chain sees at every sample.
+    // shortestSegment gets the shortest sub-block that isn't the block's last.
+    std::vector<float> renderAutomation (SubBlockAutomation<1>& automation, float hostValue, int numSamples,
+                                         int* shortestSegment = nullptr)
+    {
+        std::vector<float> values ((size_t) numSamples);
+        automation.beginBlock (&hostValue, numSamples);
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int end = automation.getSubBlockEnd (start, 32);
+            float startValue, endValue;
+            automation.getValues (start, true, &startValue);
+            automation.getValues (end, false, &endValue);
+
+            for (int i = start; i < end; ++i)
+                values[(size_t) i] = startValue + (endValue - startValue) * (float) (i - start) / (float) (end - start);
+
+            if (shortestSegment != nullptr && end < numSamples)
+                *shortestSegment = juce::jmin (*shortestSegment, end - start);
+
+            start = end;
+        }
+
+        automation.endBlock();
+        return values;
+    }
+
+    // An event at offset k must give its value from sample k on (from the block start
+    // when k is closer than minSubBlockLength to it), keep it in the next block when
+    // the parameter has that value and give way to the parameter otherwise. Dense
+    // events must not make sub-blocks shorter than minSubBlockLength. Returns false on failure.
+    bool checkSubBlockAutomation()
+    {
+        std::printf ("== Sub-block automation: event at offset k, 256-sample blocks ==\n");
+
+        const int numSamples = 256;
+        const int minLength = SubBlockAutomation<1>::minSubBlockLength;
+        const float initial = 0.0f;
+        bool passed = true;
+
+        // The parameter either already has the event's value (a timestamped editor
+        // change) or has moved on from it (a stale event, e.g. a later one was dropped)
+        for (auto parameterValue : { 1.0f, 0.0f })
+        {
+            for (auto k : { 0, 5, 100, 250, 255 })
+            {
+                SubBlockAutomation<1> automation;
+                automation.reset (&initial);
+
+                automation.addEvent (k, 0, 1.0f);
+                auto first  = renderAutomation (automation, parameterValue, numSamples);
+                auto second = renderAutomation (automation, parameterValue, numSamples);
+                auto third  = renderAutomation (automation, 0.5f, numSamples);
+
+                const int landed = k < minLength ? 0 : k;
+                bool ok = true;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    auto expected = i >= landed ? 1.0f : 0.0f;
+                    ok = ok && first[(size_t) i] == expected;
+
+                    if (parameterValue == 1.0f)
+                        ok = ok && second[(size_t) i] == 1.0f;
+                }
+
+                ok = ok && second.front() == 1.0f && std::abs (second.back() - parameterValue) < 0.01f;
+                ok = ok && third.front() == parameterValue && std::abs (third.back() - 0.5f) < 0.01f;
+                passed = passed && ok;
+
+                std::printf ("parameter %.1f, k = %3d: %s\n", parameterValue, k, ok ? "ok" : "FAILED");
+            }
+        }
+
+        {
+            // Events drained into a zero-length block must still count
+            SubBlockAutomation<1> automation;
+            automation.reset (&initial);
+            automation.addEvent (0, 0, 1.0f);
+            renderAutomation (automation, 1.0f, 0);
+            auto next = renderAutomation (automation, 1.0f, numSamples);
+
+            const bool ok = next.front() == 1.0f && next.back() == 1.0f;
+            passed = passed && ok;
+            std::printf ("zero-length block: %s\n", ok ? "ok" : "FAILED");
+        }
+
+        {
+            // An event on every sample
+            SubBlockAutomation<1> automation;
+            automation.reset (&initial);
+
+            for (int i = 0; i < numSamples; ++i)
+                automation.addEvent (i, 0, (float) i);
+
+            int shortest = numSamples;
+            auto values = renderAutomation (automation, (float) (numSamples - 1), numSamples, &shortest);
+
+            const bool ok = shortest >= minLength && values.back() == (float) (numSamples - 1);
+            passed = passed && ok;
+            std::printf ("event on every sample: shortest sub-block %d (min %d): %s\n", shortest, minLength, ok ? "ok" : "FAILED");
+        }
+
+        std::printf ("\n");
+        return passed;
+    }
+
+    //==============================================================================
+    // Nanoseconds per sample of one kernel call over a 64-sample segment
+    template <typename KernelCall>
+    double timeKernel (KernelCall&& call)
+    {
+        const int numCalls = 200000;
+        auto start = juce::Time::getHighResolutionTicks();
+
+        for (int n = 0; n < numCalls; ++n)
+            call();
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e9 / ((double) numCalls * benchBlockSize);
+    }
+
+    // ns/sample of each kernel at each ISA level this CPU supports, with the speedup over generic
+    void benchKernels()
+    {
+        std::printf ("== DSP kernels: %d-sample segments, selected: %s ==\n", benchBlockSize, getDSPKernels().name);
+
+        const char* kernelNames[] = { "saturate", "quantize", "mixRamp", "mixBuffer", "packHalf",
+                                      "unpackHalf", "packInt16", "unpackInt16", "lookupTable", "interpolate",
+                                      "saturate64", "quantize64", "mixRamp64", "mixBuffer64", "floatToDouble", "doubleToFloat" };
+        constexpr int numKernels = (int) (sizeof (kernelNames) / sizeof (kernelNames[0]));
+
+        juce::Random random (1);
+        std::vector<float> a (benchBlockSize * 5), b (benchBlockSize * 5), c (benchBlockSize * 5), table (513);
+        std::vector<double> a64 (benchBlockSize), b64 (benchBlockSize), c64 (benchBlockSize);
+        std::vector<uint16_t> packed (benchBlockSize);
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            a[i] = random.nextFloat() * 2.0f - 1.0f;
+            b[i] = random.nextFloat() * 2.0f - 1.0f;
+            c[i] = random.nextFloat();
+        }
+
+        for (size_t i = 0; i < a64.size(); ++i)
+        {
+            a64[i] = a[i];
+            c64[i] = c[i];
+        }
+
+        for (size_t i = 0; i < table.size(); ++i)
+            table[i] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * (float) i / 512.0f);
+
+        double results[DSPKernels::numLevels][numKernels] = {};
+
+        for (int level = 0; level < DSPKernels::numLevels; ++level)
+        {
+            auto* k = getDSPKernels ((DSPKernels::Level) level);
+            if (k == nullptr)
+                continue;
+
+            // The in-place kernels are fed a fresh copy each call so values stay in range
+            auto* x = b.data();
+            auto fresh = [&] { std::copy (a.begin(), a.begin() + benchBlockSize, b.begin()); };
+
+            auto* x64 = b64.data();
+            auto fresh64 = [&] { std::copy (a64.begin(), a64.end(), b64.begin()); };
+
+            double copyTime = timeKernel ([&] { fresh(); });
+            double copyTime64 = timeKernel ([&] { fresh64(); });
+
+            results[level][0] = timeKernel ([&] { fresh(); k->saturate (x, benchBlockSize, 2.0f, 0.01f); }) - copyTime;
+            results[level][1] = timeKernel ([&] { fresh(); k->quantize (x, benchBlockSize, 64.0f, 0.1f); }) - copyTime;
+            results[level][2] = timeKernel ([&] { fresh(); k->mixRamp (x, a.data(), benchBlockSize, 0.2f, 0.001f); }) - copyTime;
+            results[level][3] = timeKernel ([&] { fresh(); k->mixBuffer (x, a.data(), c.data(), benchBlockSize); }) - copyTime;
+            results[level][4] = timeKernel ([&] { k->packHalf (a.data(), packed.data(), benchBlockSize); });
+            results[level][5] = timeKernel ([&] { k->unpackHalf (packed.data(), x, benchBlockSize); });
+            results[level][6] = timeKernel ([&] { k->packInt16 (a.data(), packed.data(), benchBlockSize, 8191.75f); });
+            results[level][7] = timeKernel ([&] { k->unpackInt16 (packed.data(), x, benchBlockSize, 1.0f / 8191.75f); });
+            results[level][8] = timeKernel ([&] { k->lookupTable (table.data(), 512, 0.1f, 0.002f, x, benchBlockSize); });
+            results[level][9] = timeKernel ([&] { k->interpolate (a.data(), 0.3f, 3.7f, x, benchBlockSize); });
+            results[level][10] = timeKernel ([&] { fresh64(); k->saturate64 (x64, benchBlockSize, 2.0, 0.01); }) - copyTime64;
+            results[level][11] = timeKernel ([&] { fresh64(); k->quantize64 (x64, benchBlockSize, 64.0, 0.1); }) - copyTime64;
+            results[level][12] = timeKernel ([&] { fresh64(); k->mixRamp64 (x64, a64.data(), benchBlockSize, 0.2, 0.001); }) - copyTime64;
+            results[level][13] = timeKernel ([&] { fresh64(); k->mixBuffer64 (x64, a64.data(), c64.data(), benchBlockSize); }) - copyTime64;
+            results[level][14] = timeKernel ([&] { k->floatToDouble (a.data(), x64, benchBlockSize); });
+            results[level][15] = timeKernel ([&] { k->doubleToFloat (a64.data(), x, benchBlockSize); });
+        }
+
+        std::printf ("%-14s", "Kernel");
+        for (int level = 0; level < DSPKernels::numLevels; ++level)
+            if (auto* k = getDSPKernels ((DSPKernels::Level) level))
+                std::printf (" %10s ns %8s", k->name, "speedup");
+        std::printf ("\n");
+
+        for (int kernel = 0; kernel < numKernels; ++kernel)
+        {
+            std::printf ("%-14s", kernelNames[kernel]);
+
+            for (int level = 0; level < DSPKernels::numLevels; ++level)
+                if (getDSPKernels ((DSPKernels::Level) level) != nullptr)
+                    std::printf (" %13.3f %7.2fx", results[level][kernel],
+                                 results[0][kernel] / juce::jmax (1.0e-6, results[level][kernel]));
+
+            std::printf ("\n");
+        }
+
+        std::printf ("\n");
+    }
+
+    //==============================================================================
+    // Realtime load of the plugin's VOID reverb per session rate, full rate vs. the reduced internal rate
+    template <typename SampleType>
+    void benchVoidRate()
+    {
+        // Pre-generated so only the reverb path is timed
+        const int numNoiseSegments = 1024;
+        std::vector<SampleType> noise ((size_t) (numNoiseSegments * benchBlockSize));
+        juce::Random random (1);
+        for (auto& s : noise)
+            s = (SampleType) (random.nextFloat() * 2.0f - 1.0f);
+
+        for (auto sampleRate : { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 })
+        {
+            const int numSegments = (int) (10.0 * sampleRate) / benchBlockSize;
+            double realtime[2] = {};
+
+            RateReducer<SampleType> reducer;
+            reducer.prepare (sampleRate, 2, benchBlockSize);
+
+            for (int reduced = 0; reduced < 2; ++reduced)
+            {
+                VoidReverb<SampleType> reverb;
+                reverb.prepare ({ reduced != 0 ? reducer.getInternalRate() : sampleRate, (juce::uint32) benchBlockSize, 2 });
+
+                typename VoidReverb<SampleType>::Parameters params;
+                params.roomSize = 0.8f;
+                params.dryLevel = 0.0f;
+                params.wetLevel = 1.0f;
+                reverb.setParameters (params);
+
+                juce::AudioBuffer<SampleType> buffer (2, benchBlockSize);
+                auto start = juce::Time::getHighResolutionTicks();
+
+                for (int s = 0; s < numSegments; ++s)
+                {
+                    for (int ch = 0; ch < 2; ++ch)
+                        juce::FloatVectorOperations::copy (buffer.getWritePointer (ch),
+                                                           noise.data() + (s % numNoiseSegments) * benchBlockSize, benchBlockSize);
+
+                    auto processReverb = [&reverb] (SampleType* const* data, int num)
+                    {
+                        reverb.processStereo (data[0], data[1], num);
+                    };
+
+                    if (reduced != 0)
+                        reducer.process (buffer.getArrayOfWritePointers(), 2, benchBlockSize, processReverb);
+                    else
+                        processReverb (buffer.getArrayOfWritePointers(), benchBlockSize);
+                }
+
+                auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+                realtime[reduced] = 100.0 * seconds / 10.0;
+            }
+
+            std::printf ("%-8s %-10.0f %8d %10d %14.2f %14.2f\n", std::is_same_v<SampleType, double> ? "double" : "float",
+                         sampleRate, reducer.getFactor(), reducer.getLatencySamples(), realtime[0], realtime[1]);
+        }
+    }
+
+    // The delay the reducer reports must be the delay it has: an impulse sent through
+    // with a pass-through stage (at every phase of the decimators) has to come back with
+    // its peak exactly getLatencySamples() later. Returns false on failure.
+    template <typename SampleType>
+    bool checkVoidLatency()
+    {
+        bool passed = true;
+
+        for (auto sampleRate : { 88200.0, 96000.0, 192000.0 })
+        {
+            RateReducer<SampleType> reducer;
+            reducer.prepare (sampleRate, 2, benchBlockSize);
+
+            const int latency = reducer.getLatencySamples();
+            const int length = ((latency + 4 * benchBlockSize) / benchBlockSize + 1) * benchBlockSize;
+            int worstError = 0;
+
+            for (int phase = 0; phase < reducer.getFactor(); ++phase)
+            {
+                const int impulseAt = benchBlockSize + phase;
+                std::vector<SampleType> left ((size_t) length), right ((size_t) length);
+                left[(size_t) impulseAt] = right[(size_t) impulseAt] = (SampleType) 1;
+
+                reducer.reset();
+
+                for (int start = 0; start < length; start += benchBlockSize)
+                {
+                    SampleType* channels[] = { left.data() + start, right.data() + start };
+                    reducer.process (channels, 2, benchBlockSize, [] (SampleType* const*, int) {});
+                }
+
+                for (auto* channel : { &left, &right })
+                {
+                    auto peak = std::max_element (channel->begin(), channel->end(),
+                                                  [] (SampleType a, SampleType b) { return std::abs (a) < std::abs (b); });
+                    auto measured = (int) std::distance (channel->begin(), peak) - impulseAt;
+                    worstError = juce::jmax (worstError, std::abs (measured - latency));
+                }
+            }
+
+            std::printf ("%-8s %-10.0f %10d %20s\n", std::is_same_v<SampleType, double> ? "double" : "float",
+                         sampleRate, latency, worstError == 0 ? "ok" : "FAILED");
+            passed = passed && worstError == 0;
+        }
+
+        return passed;
+    }
+
+    //==============================================================================
+    // Message-thread cost of one visualizer frame for growing ember counts: step, render
+    // into the layer, and the software paint of just the changed areas vs. the whole layer
+    void benchEmberField()
+    {
+        std::printf ("== Visualizer embers: 250x180 layer, 6000 frames ==\n");
+        std::printf ("%-10s %12s %12s %16s %17s %16s\n",
+                     "Embers", "Step (us)", "Render (us)", "Changed px/frame", "Paint dirty (us)", "Paint full (us)");
+
+        const int width = 250, height = 180, numFrames = 6000;
+        juce::Image canvas (juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+        juce::Graphics g (canvas);
+
+        auto paintLayer = [&g] (const juce::Image& layer)
+        {
+            g.fillAll (juce::Colours::black);
+            g.setColour (juce::Colours::red);
+            g.drawImageAt (layer, 0, 0, true);
+        };
+
+        for (auto numEmbers : { 50, 1024, 4096, 16384 })
+        {
+            EmberField embers;
+            embers.setNumEmbers (numEmbers);
+            juce::Image layer (juce::Image::SingleChannel, width, height, true, juce::SoftwareImageType());
+
+            juce::int64 stepTicks = 0, renderTicks = 0, dirtyTicks = 0, fullTicks = 0;
+            double changedPixels = 0.0;
+
+            for (int frame = 0; frame < numFrames; ++frame)
+            {
+                auto start = juce::Time::getHighResolutionTicks();
+                embers.step (1.0f + 2.5f * (float) (frame % 120) / 120.0f);
+                auto stepped = juce::Time::getHighResolutionTicks();
+
+                {
+                    juce::Image::BitmapData data (layer, juce::Image::BitmapData::readWrite);
+                    embers.render (data.data, data.width, data.height, data.lineStride, 0.5f * width, 0.5f * height);
+                }
+
+                auto rendered = juce::Time::getHighResolutionTicks();
+
+                // What the visualizer repaints (the peer merges the areas into one region)
+                juce::RectangleList<int> dirty;
+                embers.forEachChangedArea ([&] (const EmberField::Bounds& area)
+                {
+                    changedPixels += (double) (area.right - area.left) * (area.bottom - area.top);
+                    dirty.add ({ area.left, area.top, area.right - area.left, area.bottom - area.top });
+                });
+
+                g.saveState();
+                if (g.reduceClipRegion (dirty))
+                    paintLayer (layer);
+                g.restoreState();
+                auto paintedDirty = juce::Time::getHighResolutionTicks();
+
+                paintLayer (layer);
+                auto paintedFull = juce::Time::getHighResolutionTicks();
+
+                stepTicks += stepped - start;
+                renderTicks += rendered - stepped;
+                dirtyTicks += paintedDirty - rendered;
+                fullTicks += paintedFull - paintedDirty;
+            }
+
+            auto toUs = [] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6 / numFrames; };
+
+            std::printf ("%-10d %12.2f %12.2f %16.0f %17.2f %16.2f\n", numEmbers, toUs (stepTicks), toUs (renderTicks),
+                         changedPixels / numFrames, toUs (dirtyTicks), toUs (fullTicks));
+        }
+
+        std::printf ("\n");
+    }
+}
+
+//==============================================================================
+int main (int, char**)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    bool passed = checkSubBlockAutomation();
+    passed = checkEnvelopeSplitting() && passed;
+
+    std::printf ("== VOID reduced rate: reported latency vs. measured impulse delay ==\n");
+    std::printf ("%-8s %-10s %10s %20s\n", "Type", "Rate", "Latency", "Impulse peak at +L");
+    passed = checkVoidLatency<float>() && passed;
+    passed = checkVoidLatency<double>() && passed;
+    std::printf ("\n");
+
+    benchKernels();
+    benchModulationMatrix();
+    benchDelayMemory();
+    benchGrainEngine();
+    std::printf ("== VOID reverb: 10s stereo, %d-sample segments ==\n", benchBlockSize);
+    std::printf ("%-8s %-10s %8s %10s %14s %14s\n", "Type", "Rate", "Factor", "Latency", "Full (RT %)", "Reduced (RT %)");
+    benchVoidRate<float>();
+    benchVoidRate<double>();
+    std::printf ("\n");
+    benchEmberField();
+
+    return passed ? 0 : 1;
+}
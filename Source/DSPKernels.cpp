@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    DSPKernels.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSPKernels.h"
+
+// Generic build: baseline flags of the target
+#define DSP_KERNELS_NAMESPACE DSPKernelsGeneric
+#define DSP_KERNELS_NAME "Generic"
+#include "DSPKernelsImpl.h"
+
+#if ABYSSAL_KERNELS_X86
+namespace DSPKernelsSSE41  { extern const DSPKernels kernels; }
+namespace DSPKernelsAVX2   { extern const DSPKernels kernels; }
+namespace DSPKernelsAVX512 { extern const DSPKernels kernels; }
+
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+
+// The AVX2 and AVX-512 builds pack half floats with F16C, which SystemStats doesn't report
+static bool hasF16C()
+{
+   #if JUCE_MSVC
+    int info[4] = {};
+    __cpuid (info, 1);
+    return (info[2] & (1 << 29)) != 0;
+   #else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid (1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_F16C) != 0;
+   #endif
+}
+#endif
+
+//==============================================================================
+const DSPKernels* getDSPKernels (DSPKernels::Level level)
+{
+    switch (level)
+    {
+        case DSPKernels::generic:
+            return &DSPKernelsGeneric::kernels;
+
+       #if ABYSSAL_KERNELS_X86
+        case DSPKernels::sse41:
+            return juce::SystemStats::hasSSE41() ? &DSPKernelsSSE41::kernels : nullptr;
+
+        case DSPKernels::avx2:
+            return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3() && hasF16C() ? &DSPKernelsAVX2::kernels : nullptr;
+
+        case DSPKernels::avx512:
+            return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL()
+                && juce::SystemStats::hasAVX512BW() && juce::SystemStats::hasAVX512DQ() && hasF16C() ? &DSPKernelsAVX512::kernels : nullptr;
+       #endif
+
+        default:
+            return nullptr;
+    }
+}
+
+const DSPKernels& getDSPKernels()
+{
+    static const DSPKernels& best = []() -> const DSPKernels&
+    {
+        for (int level = DSPKernels::numLevels - 1; level > DSPKernels::generic; --level)
+            if (auto* k = getDSPKernels ((DSPKernels::Level) level))
+                return *k;
+
+        return DSPKernelsGeneric::kernels;
+    }();
+
+    return best;
+}
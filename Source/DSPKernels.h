@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    DSPKernels.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// The hot inner loops of the chain, compiled once per ISA level and picked at
+// load time from the CPU features, so one binary runs everywhere.
+// Ramped kernels use value = start + increment * (i + 1) for sample i.
+struct DSPKernels
+{
+    enum Level
+    {
+        generic = 0,
+        sse41,
+        avx2,     // + FMA, F16C
+        avx512,   // F, VL, BW, DQ
+        numLevels
+    };
+
+    const char* name;
+
+    // Corruption: data = tanh (data * drive)
+    void (*saturate) (float* data, int numSamples, float driveStart, float driveIncrement);
+    // Erosion: data = round (data * steps) / steps
+    void (*quantize) (float* data, int numSamples, float stepsStart, float stepsIncrement);
+    // Drown: wet = dry + (wet - dry) * mix
+    void (*mixRamp)   (float* wet, const float* dry, int numSamples, float mixStart, float mixIncrement);
+    void (*mixBuffer) (float* wet, const float* dry, const float* mix, int numSamples);
+
+    // The same four at double precision (native 64-bit hosts)
+    void (*saturate64)  (double* data, int numSamples, double driveStart, double driveIncrement);
+    void (*quantize64)  (double* data, int numSamples, double stepsStart, double stepsIncrement);
+    void (*mixRamp64)   (double* wet, const double* dry, int numSamples, double mixStart, double mixIncrement);
+    void (*mixBuffer64) (double* wet, const double* dry, const double* mix, int numSamples);
+
+    // Precision conversion
+    void (*floatToDouble) (const float* src, double* dest, int numSamples);
+    void (*doubleToFloat) (const double* src, float* dest, int numSamples);
+
+    // Whispers memory
+    void (*packHalf)    (const float* src, uint16_t* dest, int numSamples);
+    void (*unpackHalf)  (const uint16_t* src, float* dest, int numSamples);
+    void (*packInt16)   (const float* src, uint16_t* dest, int numSamples, float scale);
+    void (*unpackInt16) (const uint16_t* src, float* dest, int numSamples, float scale);
+
+    // Grains: dest[i] = table[(phase + increment * i) * tableSize] (linear, phase clamped to 1)
+    void (*lookupTable) (const float* table, int tableSize, float phase, float increment, float* dest, int numSamples);
+    // Grains: dest[i] = src[frac + increment * i] (linear, src must hold the whole span)
+    void (*interpolate) (const float* src, float frac, float increment, float* dest, int numSamples);
+};
+
+// Best kernels for this CPU (selected once, on first use).
+const DSPKernels& getDSPKernels();
+
+// A specific level, or nullptr if it isn't built in or this CPU can't run it.
+const DSPKernels* getDSPKernels (DSPKernels::Level level);
+
+// Chain kernels by sample type, for the code templated on float / double
+inline void saturate (const DSPKernels& k, float* data, int numSamples, float driveStart, float driveIncrement)       { k.saturate (data, numSamples, driveStart, driveIncrement); }
+inline void saturate (const DSPKernels& k, double* data, int numSamples, double driveStart, double driveIncrement)    { k.saturate64 (data, numSamples, driveStart, driveIncrement); }
+inline void quantize (const DSPKernels& k, float* data, int numSamples, float stepsStart, float stepsIncrement)       { k.quantize (data, numSamples, stepsStart, stepsIncrement); }
+inline void quantize (const DSPKernels& k, double* data, int numSamples, double stepsStart, double stepsIncrement)    { k.quantize64 (data, numSamples, stepsStart, stepsIncrement); }
+inline void mixRamp (const DSPKernels& k, float* wet, const float* dry, int numSamples, float mixStart, float mixIncrement)     { k.mixRamp (wet, dry, numSamples, mixStart, mixIncrement); }
+inline void mixRamp (const DSPKernels& k, double* wet, const double* dry, int numSamples, double mixStart, double mixIncrement) { k.mixRamp64 (wet, dry, numSamples, mixStart, mixIncrement); }
+inline void mixBuffer (const DSPKernels& k, float* wet, const float* dry, const float* mix, int numSamples)       { k.mixBuffer (wet, dry, mix, numSamples); }
+inline void mixBuffer (const DSPKernels& k, double* wet, const double* dry, const double* mix, int numSamples)    { k.mixBuffer64 (wet, dry, mix, numSamples); }
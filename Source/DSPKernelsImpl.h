@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    DSPKernelsImpl.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    Kernel bodies, included once per ISA translation unit with
+    DSP_KERNELS_NAMESPACE set. Plain loops the compiler vectorizes for the
+    target flags of that file.
+
+    Everything in here must stay inside the namespace and must not call inline
+    functions from other headers (juce::jlimit, std::min...): the linker could
+    otherwise keep the AVX copy of such a function for the generic callers.
+
+  ==============================================================================
+*/
+
+#ifndef DSP_KERNELS_NAMESPACE
+ #error "Define DSP_KERNELS_NAMESPACE before including DSPKernelsImpl.h"
+#endif
+
+#include "DSPKernels.h"
+#include <math.h>
+#include <cstring>
+
+#if defined (__F16C__) || (defined (_MSC_VER) && defined (__AVX2__))
+ #define DSP_KERNELS_F16C 1
+ #include <immintrin.h>
+#endif
+
+namespace DSP_KERNELS_NAMESPACE
+{
+namespace
+{
+    template <typename T>
+    inline T clampValue (T x, T lo, T hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+    // Halves away from zero, as the original std::round quantizer did (vectorizes with SSE4.1+)
+    inline float roundNearest (float x)   { return roundf (x); }
+    inline double roundNearest (double x) { return round (x); }
+
+    // tanh to double precision (within 4e-16 of std::tanh): -expm1 (-2|x|) / (2 + expm1 (-2|x|)),
+    // with expm1 from a 2^n range reduction and a Taylor polynomial, so it still vectorizes
+    inline double accurateTanh (double x)
+    {
+        const double a = clampValue (fabs (x), 0.0, 20.0); // tanh (20) is 1 in double
+        const double y = -2.0 * a;
+
+        // y = n ln2 + r, |r| <= ln2 / 2 (ln2 split in two so n ln2 is exact)
+        const int n = (int) (y * 1.4426950408889634 - 0.5);
+        const double nd = (double) n;
+        const double r = (y - nd * 6.93147180369123816490e-01) - nd * 1.90821492927058770002e-10;
+
+        double p = 1.0 / 6227020800.0; // 1/13!
+        p = p * r + 1.0 / 479001600.0;
+        p = p * r + 1.0 / 39916800.0;
+        p = p * r + 1.0 / 3628800.0;
+        p = p * r + 1.0 / 362880.0;
+        p = p * r + 1.0 / 40320.0;
+        p = p * r + 1.0 / 5040.0;
+        p = p * r + 1.0 / 720.0;
+        p = p * r + 1.0 / 120.0;
+        p = p * r + 1.0 / 24.0;
+        p = p * r + 1.0 / 6.0;
+        p = p * r + 0.5;
+        p = p * r + 1.0;
+        const double expm1r = p * r;
+
+        const uint64_t bits = (uint64_t) (1023 + n) << 52;
+        double scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+
+        const double m = scale * expm1r + (scale - 1.0); // expm1 (y)
+        const double t = -m / (2.0 + m);
+        return x < 0.0 ? -t : t;
+    }
+
+    // Rational tanh, within 4e-7 of std::tanh: fine for float, too coarse for double
+    inline float rationalTanh (float x)
+    {
+        x = clampValue<float> (x, (float) -7.90531110763549805, (float) 7.90531110763549805);
+        float x2 = x * x;
+        float p = (float) -2.76076847742355e-16;
+        p = p * x2 + (float) 2.00018790482477e-13;
+        p = p * x2 + (float) -8.60467152213735e-11;
+        p = p * x2 + (float) 5.12229709037114e-08;
+        p = p * x2 + (float) 1.48572235717979e-05;
+        p = p * x2 + (float) 6.37261928875436e-04;
+        p = p * x2 + (float) 4.89352455891786e-03;
+        float q = (float) 1.19825839466702e-06;
+        q = q * x2 + (float) 1.18534705686654e-04;
+        q = q * x2 + (float) 2.26843463243900e-03;
+        q = q * x2 + (float) 4.89352518554385e-03;
+        return x * p / q;
+    }
+
+    inline float fastTanh (float x)   { return rationalTanh (x); }
+    inline double fastTanh (double x) { return accurateTanh (x); }
+
+    //==============================================================================
+    // Chain kernels, instantiated for float and double
+    template <typename T>
+    void saturate (T* data, int numSamples, T driveStart, T driveIncrement)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = fastTanh (data[i] * (driveStart + driveIncrement * (T) (i + 1)));
+    }
+
+    template <typename T>
+    void quantize (T* data, int numSamples, T stepsStart, T stepsIncrement)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            T steps = stepsStart + stepsIncrement * (T) (i + 1);
+            data[i] = roundNearest (data[i] * steps) / steps;
+        }
+    }
+
+    template <typename T>
+    void mixRamp (T* wet, const T* dry, int numSamples, T mixStart, T mixIncrement)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            wet[i] = dry[i] + (wet[i] - dry[i]) * (mixStart + mixIncrement * (T) (i + 1));
+    }
+
+    template <typename T>
+    void mixBuffer (T* wet, const T* dry, const T* mix, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            wet[i] = dry[i] + (wet[i] - dry[i]) * mix[i];
+    }
+
+    void floatToDouble (const float* src, double* dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = (double) src[i];
+    }
+
+    void doubleToFloat (const double* src, float* dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = (float) src[i];
+    }
+
+    //==============================================================================
+    // Half conversion: round-to-nearest-even, denormals kept, out of range saturates
+    constexpr uint32_t halfDenormMagicBits = (uint32_t) ((127 - 15) + (23 - 10) + 1) << 23; // 0.5f
+    constexpr uint32_t halfRenormBits = 113u << 23;                                           // 2^-14
+
+    inline float bitsToFloat (uint32_t bits) { float f; std::memcpy (&f, &bits, sizeof (f)); return f; }
+    inline uint32_t floatToBits (float f)    { uint32_t u; std::memcpy (&u, &f, sizeof (u)); return u; }
+
+    void packHalf (const float* src, uint16_t* dest, int numSamples)
+    {
+        int i = 0;
+
+       #if DSP_KERNELS_F16C
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            auto x = _mm256_min_ps (_mm256_max_ps (_mm256_loadu_ps (src + i), _mm256_set1_ps (-65504.0f)), _mm256_set1_ps (65504.0f));
+            _mm_storeu_si128 ((__m128i*) (dest + i), _mm256_cvtps_ph (x, _MM_FROUND_TO_NEAREST_INT));
+        }
+       #endif
+
+        for (; i < numSamples; ++i)
+        {
+            auto bits = floatToBits (clampValue (src[i], -65504.0f, 65504.0f));
+            auto sign = bits & 0x80000000u;
+            bits ^= sign;
+
+            // Denormal / zero: let the FPU round through a magic add
+            auto denormalBits = floatToBits (bitsToFloat (bits) + bitsToFloat (halfDenormMagicBits)) - halfDenormMagicBits;
+            // Normal: rebias the exponent and round to nearest even
+            auto normalBits = (bits + ((uint32_t) (15 - 127) << 23) + 0xfffu + ((bits >> 13) & 1u)) >> 13;
+
+            auto result = bits < (113u << 23) ? denormalBits : normalBits;
+            dest[i] = (uint16_t) (result | (sign >> 16));
+        }
+    }
+
+    void unpackHalf (const uint16_t* src, float* dest, int numSamples)
+    {
+        int i = 0;
+
+       #if DSP_KERNELS_F16C
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps (dest + i, _mm256_cvtph_ps (_mm_loadu_si128 ((const __m128i*) (src + i))));
+       #endif
+
+        for (; i < numSamples; ++i)
+        {
+            uint32_t h = src[i];
+            uint32_t bits = ((h & 0x7fffu) << 13) + ((uint32_t) (127 - 15) << 23);
+
+            // Half denormals: renormalise through a float subtract
+            auto denormalBits = floatToBits (bitsToFloat (bits + (1u << 23)) - bitsToFloat (halfRenormBits));
+
+            bits = (h & 0x7c00u) == 0 ? denormalBits : bits;
+            dest[i] = bitsToFloat (bits | ((h & 0x8000u) << 16));
+        }
+    }
+
+    void packInt16 (const float* src, uint16_t* dest, int numSamples, float scale)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = clampValue (src[i] * scale, -32767.0f, 32767.0f);
+            dest[i] = (uint16_t) (int16_t) (int32_t) (x + (x >= 0.0f ? 0.5f : -0.5f));
+        }
+    }
+
+    void unpackInt16 (const uint16_t* src, float* dest, int numSamples, float scale)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = (float) (int16_t) src[i] * scale;
+    }
+
+    //==============================================================================
+    void lookupTable (const float* table, int tableSize, float phase, float increment, float* dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float position = clampValue (phase + increment * (float) i, 0.0f, 1.0f) * (float) tableSize;
+            int index = (int) position;
+            index = index < tableSize - 1 ? index : tableSize - 1;
+            float frac = position - (float) index;
+            dest[i] = table[index] + frac * (table[index + 1] - table[index]);
+        }
+    }
+
+    void interpolate (const float* src, float frac, float increment, float* dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float position = frac + increment * (float) i;
+            int index = (int) position;
+            float f = position - (float) index;
+            dest[i] = src[index] + f * (src[index + 1] - src[index]);
+        }
+    }
+}
+
+    //==============================================================================
+    extern const DSPKernels kernels;
+
+    const DSPKernels kernels
+    {
+        DSP_KERNELS_NAME,
+        saturate<float>,
+        quantize<float>,
+        mixRamp<float>,
+        mixBuffer<float>,
+        saturate<double>,
+        quantize<double>,
+        mixRamp<double>,
+        mixBuffer<double>,
+        floatToDouble,
+        doubleToFloat,
+        packHalf,
+        unpackHalf,
+        packInt16,
+        unpackInt16,
+        lookupTable,
+        interpolate
+    };
+}
+
+#undef DSP_KERNELS_F16C
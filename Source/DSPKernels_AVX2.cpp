@@ -0,0 +1,15 @@
+/*
+  ==============================================================================
+
+    DSPKernels_AVX2.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    AVX2 build of the DSP kernels (flags set in CMakeLists.txt).
+
+  ==============================================================================
+*/
+
+#define DSP_KERNELS_NAMESPACE DSPKernelsAVX2
+#define DSP_KERNELS_NAME "AVX2"
+#include "DSPKernelsImpl.h"
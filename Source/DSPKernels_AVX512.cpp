@@ -0,0 +1,15 @@
+/*
+  ==============================================================================
+
+    DSPKernels_AVX512.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    AVX-512 build of the DSP kernels (flags set in CMakeLists.txt).
+
+  ==============================================================================
+*/
+
+#define DSP_KERNELS_NAMESPACE DSPKernelsAVX512
+#define DSP_KERNELS_NAME "AVX-512"
+#include "DSPKernelsImpl.h"
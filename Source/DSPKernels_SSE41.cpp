@@ -0,0 +1,15 @@
+/*
+  ==============================================================================
+
+    DSPKernels_SSE41.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    SSE4.1 build of the DSP kernels (flags set in CMakeLists.txt).
+
+  ==============================================================================
+*/
+
+#define DSP_KERNELS_NAMESPACE DSPKernelsSSE41
+#define DSP_KERNELS_NAME "SSE4.1"
+#include "DSPKernelsImpl.h"
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    DelayMemory.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPKernels.h"
+
+// Circular multi-channel sample memory for Whispers.
+// Samples can be stored as 32-bit float, 16-bit half-float, scaled int16 or
+// 64-bit double. The 16-bit formats halve the footprint of long delays / freeze
+// buffers; they are packed and unpacked a block at a time by the dispatched
+// DSPKernels. Reads and writes take float or double samples in any format.
+class DelayMemory
+{
+public:
+    enum Format
+    {
+        float32 = 0,
+        half16,
+        int16,
+        float64,
+        numFormats
+    };
+
+    // int16 full scale. The feedback loop can go well above 0dBFS, so keep +12dB of headroom.
+    static constexpr float int16Headroom = 4.0f;
+
+    //==============================================================================
+    // Allocates the memory: message thread / prepareToPlay only.
+    void prepare (int newNumChannels, int newLength, Format newFormat)
+    {
+        numChannels = newNumChannels;
+        length = juce::jmax (1, newLength);
+        format = newFormat;
+
+        floatData.clear();
+        doubleData.clear();
+        packedData.clear();
+        floatData.shrink_to_fit();
+        doubleData.shrink_to_fit();
+        packedData.shrink_to_fit();
+
+        const auto size = (size_t) numChannels * (size_t) length;
+
+        if (format == float32)
+            floatData.resize (size, 0.0f);
+        else if (format == float64)
+            doubleData.resize (size, 0.0);
+        else
+            packedData.resize (size, 0);
+    }
+
+    // Exchanges the storage with other's, without allocating: lets a memory prepared
+    // off the audio thread replace this one under the callback lock.
+    void swap (DelayMemory& other) noexcept
+    {
+        std::swap (numChannels, other.numChannels);
+        std::swap (length, other.length);
+        std::swap (format, other.format);
+        floatData.swap (other.floatData);
+        doubleData.swap (other.doubleData);
+        packedData.swap (other.packedData);
+    }
+
+    void clear()
+    {
+        std::fill (floatData.begin(), floatData.end(), 0.0f);
+        std::fill (doubleData.begin(), doubleData.end(), 0.0);
+        std::fill (packedData.begin(), packedData.end(), (uint16_t) 0);
+    }
+
+    int getNumChannels() const noexcept  { return numChannels; }
+    int getLength() const noexcept       { return length; }
+    Format getFormat() const noexcept    { return format; }
+
+    size_t getMemoryBytes() const noexcept
+    {
+        return floatData.size() * sizeof (float) + doubleData.size() * sizeof (double) + packedData.size() * sizeof (uint16_t);
+    }
+
+    //==============================================================================
+    // Reads numSamples starting at position (wrapped) into dest.
+    template <typename SampleType>
+    void read (int channel, int position, SampleType* dest, int numSamples) const noexcept
+    {
+        position = wrap (position);
+
+        while (numSamples > 0)
+        {
+            auto num = juce::jmin (numSamples, length - position);
+            readSpan ((size_t) channel * (size_t) length + (size_t) position, dest, num);
+
+            dest += num;
+            numSamples -= num;
+            position = 0;
+        }
+    }
+
+    // Writes numSamples from src starting at position (wrapped).
+    template <typename SampleType>
+    void write (int channel, int position, const SampleType* src, int numSamples) noexcept
+    {
+        position = wrap (position);
+
+        while (numSamples > 0)
+        {
+            auto num = juce::jmin (numSamples, length - position);
+            writeSpan ((size_t) channel * (size_t) length + (size_t) position, src, num);
+
+            src += num;
+            numSamples -= num;
+            position = 0;
+        }
+    }
+
+    int wrap (int position) const noexcept
+    {
+        position %= length;
+        return position < 0 ? position + length : position;
+    }
+
+private:
+    // Packed formats go through float in chunks of this when the caller works in double
+    static constexpr int conversionChunk = 64;
+
+    void readSpan (size_t offset, float* dest, int num) const noexcept
+    {
+        switch (format)
+        {
+            case float32: juce::FloatVectorOperations::copy (dest, floatData.data() + offset, num); break;
+            case half16:  kernels.unpackHalf (packedData.data() + offset, dest, num); break;
+            case int16:   kernels.unpackInt16 (packedData.data() + offset, dest, num, int16Headroom / 32767.0f); break;
+            case float64: kernels.doubleToFloat (doubleData.data() + offset, dest, num); break;
+            default:      jassertfalse; break;
+        }
+    }
+
+    void readSpan (size_t offset, double* dest, int num) const noexcept
+    {
+        switch (format)
+        {
+            case float64: juce::FloatVectorOperations::copy (dest, doubleData.data() + offset, num); break;
+            case float32: kernels.floatToDouble (floatData.data() + offset, dest, num); break;
+            default:
+            {
+                float chunk[conversionChunk];
+
+                for (int done = 0; done < num; done += conversionChunk)
+                {
+                    auto n = juce::jmin (conversionChunk, num - done);
+                    readSpan (offset + (size_t) done, chunk, n);
+                    kernels.floatToDouble (chunk, dest + done, n);
+                }
+                break;
+            }
+        }
+    }
+
+    void writeSpan (size_t offset, const float* src, int num) noexcept
+    {
+        switch (format)
+        {
+            case float32: juce::FloatVectorOperations::copy (floatData.data() + offset, src, num); break;
+            case half16:  kernels.packHalf (src, packedData.data() + offset, num); break;
+            case int16:   kernels.packInt16 (src, packedData.data() + offset, num, 32767.0f / int16Headroom); break;
+            case float64: kernels.floatToDouble (src, doubleData.data() + offset, num); break;
+            default:      jassertfalse; break;
+        }
+    }
+
+    void writeSpan (size_t offset, const double* src, int num) noexcept
+    {
+        switch (format)
+        {
+            case float64: juce::FloatVectorOperations::copy (doubleData.data() + offset, src, num); break;
+            case float32: kernels.doubleToFloat (src, floatData.data() + offset, num); break;
+            default:
+            {
+                float chunk[conversionChunk];
+
+                for (int done = 0; done < num; done += conversionChunk)
+                {
+                    auto n = juce::jmin (conversionChunk, num - done);
+                    kernels.doubleToFloat (src + done, chunk, n);
+                    writeSpan (offset + (size_t) done, chunk, n);
+                }
+                break;
+            }
+        }
+    }
+
+    const DSPKernels& kernels = getDSPKernels();
+
+    int numChannels = 0;
+    int length = 1;
+    Format format = float32;
+
+    std::vector<float> floatData;
+    std::vector<double> doubleData;
+    std::vector<uint16_t> packedData;
+};
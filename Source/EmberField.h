@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    EmberField.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The visualizer's embers, stored as structure-of-arrays so a step is a few
+// vector loops over the whole field. Directions come from a precomputed table
+// (no trig per frame), random numbers from the field's own generator, and
+// rendering stamps precomputed sprites into an 8-bit coverage layer that the
+// component draws with a single image blit. Each render only clears the pixels
+// the previous one drew and reports the few small areas that changed, so the
+// component can repaint just those. Nothing allocates after setNumEmbers().
+class EmberField
+{
+public:
+    static constexpr int numDirections = 256;
+    static constexpr int numSpriteSizes = 7;   // 1 to 4 px across, in 0.5 px steps
+    static constexpr int maxSpriteSize = 6;
+    static constexpr float fadePerStep = 0.02f;
+
+    // Layer pixel area, right / bottom exclusive
+    struct Bounds
+    {
+        int left = 0, top = 0, right = 0, bottom = 0;
+
+        bool isEmpty() const noexcept  { return right <= left || bottom <= top; }
+
+        Bounds getUnion (const Bounds& other) const noexcept
+        {
+            if (isEmpty())        return other;
+            if (other.isEmpty())  return *this;
+
+            return { juce::jmin (left, other.left), juce::jmin (top, other.top),
+                     juce::jmax (right, other.right), juce::jmax (bottom, other.bottom) };
+        }
+    };
+
+    //==============================================================================
+    EmberField()
+    {
+        for (int i = 0; i < numDirections; ++i)
+        {
+            auto angle = juce::MathConstants<float>::twoPi * (float) i / (float) numDirections;
+            directionX[(size_t) i] = std::cos (angle);
+            directionY[(size_t) i] = std::sin (angle);
+        }
+
+        for (int i = 0; i < numSpriteSizes; ++i)
+            sprites[(size_t) i].build (1.0f + 0.5f * (float) i);
+    }
+
+    void setNumEmbers (int numEmbers)
+    {
+        const auto n = (size_t) juce::jmax (0, numEmbers);
+        x.assign (n, 0.0f);
+        y.assign (n, 0.0f);
+        velocityX.assign (n, 0.0f);
+        velocityY.assign (n, 0.0f);
+        alpha.assign (n, 0.0f);
+        spriteIndex.assign (n, 0);
+        drawn.assign (n, {});
+        previous.assign (n, {});
+        drawnArea = {};
+
+        // Staggered ages, so the field doesn't pulse in sync
+        for (int i = 0; i < numEmbers; ++i)
+        {
+            spawn (i);
+            alpha[(size_t) i] = random.nextFloat();
+        }
+    }
+
+    int getNumEmbers() const noexcept { return (int) alpha.size(); }
+
+    //==============================================================================
+    // One fixed step: every ember moves by its velocity times speedScale and fades.
+    void step (float speedScale) noexcept
+    {
+        const int n = getNumEmbers();
+        if (n == 0)
+            return;
+
+        juce::FloatVectorOperations::addWithMultiply (x.data(), velocityX.data(), speedScale, n);
+        juce::FloatVectorOperations::addWithMultiply (y.data(), velocityY.data(), speedScale, n);
+        juce::FloatVectorOperations::add (alpha.data(), -fadePerStep, n);
+
+        for (int i = 0; i < n; ++i)
+            if (alpha[(size_t) i] <= 0.0f)
+                spawn (i);
+    }
+
+    // Composites every ember into the layer ("over", one shared colour) after clearing
+    // what the previous call drew, so the layer must be the same one each time (or a
+    // cleared one). Ember positions are relative to (centreX, centreY) in layer pixels.
+    void render (juce::uint8* layer, int width, int height, int lineStride, float centreX, float centreY) noexcept
+    {
+        // Everything is cleared before anything is stamped: old and new embers overlap
+        std::swap (drawn, previous);
+
+        for (const auto& area : previous)
+        {
+            const int right = juce::jmin (area.right, width), bottom = juce::jmin (area.bottom, height);
+
+            for (int row = area.top; row < bottom && area.left < right; ++row)
+                std::memset (layer + row * lineStride + area.left, 0, (size_t) (right - area.left));
+        }
+
+        drawnArea = {};
+        const int n = getNumEmbers();
+
+        for (int i = 0; i < n; ++i)
+        {
+            const auto& sprite = sprites[(size_t) spriteIndex[(size_t) i]];
+            const int left = juce::roundToInt (centreX + x[(size_t) i]) - sprite.size / 2;
+            const int top  = juce::roundToInt (centreY + y[(size_t) i]) - sprite.size / 2;
+
+            if (left >= width || top >= height || left + sprite.size <= 0 || top + sprite.size <= 0)
+            {
+                drawn[(size_t) i] = {};
+                continue;
+            }
+
+            const int sx0 = juce::jmax (0, -left), sx1 = juce::jmin (sprite.size, width - left);
+            const int sy0 = juce::jmax (0, -top),  sy1 = juce::jmin (sprite.size, height - top);
+            const int level = (int) (alpha[(size_t) i] * 256.0f);
+
+            drawn[(size_t) i] = { left + sx0, top + sy0, left + sx1, top + sy1 };
+            drawnArea = drawnArea.getUnion (drawn[(size_t) i]);
+
+            for (int sy = sy0; sy < sy1; ++sy)
+            {
+                auto* dest = layer + (top + sy) * lineStride + left;
+                const auto* coverage = sprite.coverage.data() + sy * sprite.size;
+
+                for (int sx = sx0; sx < sx1; ++sx)
+                {
+                    const int src = (coverage[sx] * level) >> 8;
+                    const int dst = dest[sx];
+                    dest[sx] = (juce::uint8) (dst + ((src * (255 - dst) + 255) >> 8));
+                }
+            }
+        }
+    }
+
+    // Calls fn (const Bounds&) for every area the last render() changed: each ember's
+    // previous and current sprite. Areas may overlap.
+    template <typename Function>
+    void forEachChangedArea (Function&& fn) const
+    {
+        for (const auto* areas : { &previous, &drawn })
+            for (const auto& area : *areas)
+                if (! area.isEmpty())
+                    fn (area);
+    }
+
+    // Bounding box of everything the last render() drew
+    Bounds getDrawnArea() const noexcept  { return drawnArea; }
+
+private:
+    //==============================================================================
+    // Antialiased disc coverage, centred on the corner between the middle pixels
+    struct Sprite
+    {
+        void build (float diameter)
+        {
+            const auto radius = 0.5f * diameter;
+            size = 2 * (int) std::ceil (radius + 0.5f);
+            const auto centre = 0.5f * (float) size;
+
+            for (int py = 0; py < size; ++py)
+            {
+                for (int px = 0; px < size; ++px)
+                {
+                    auto distance = std::hypot ((float) px + 0.5f - centre, (float) py + 0.5f - centre);
+                    auto value = juce::jlimit (0.0f, 1.0f, radius + 0.5f - distance);
+                    coverage[(size_t) (py * size + px)] = (juce::uint8) juce::roundToInt (value * 255.0f);
+                }
+            }
+        }
+
+        int size = 0;
+        std::array<juce::uint8, maxSpriteSize * maxSpriteSize> coverage {};
+    };
+
+    void spawn (int i) noexcept
+    {
+        const auto direction = (size_t) random.nextInt (numDirections);
+        const auto speed = 1.0f + random.nextFloat() * 2.0f;
+
+        x[(size_t) i] = 0.0f;
+        y[(size_t) i] = 0.0f;
+        velocityX[(size_t) i] = directionX[direction] * speed;
+        velocityY[(size_t) i] = directionY[direction] * speed;
+        alpha[(size_t) i] = 1.0f;
+        spriteIndex[(size_t) i] = random.nextInt (numSpriteSizes);
+    }
+
+    std::array<float, numDirections> directionX {}, directionY {};
+    std::array<Sprite, numSpriteSizes> sprites;
+
+    std::vector<float> x, y, velocityX, velocityY, alpha;
+    std::vector<int> spriteIndex;
+    juce::Random random;
+
+    std::vector<Bounds> drawn, previous; // per ember, clipped to the layer
+    Bounds drawnArea;
+};
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    GrainEngine.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayMemory.h"
+#include "DSPKernels.h"
+
+// Granular Whispers: windowed grains read back from the delay history.
+// All grains live in a fixed pool allocated in prepare(); the audio thread
+// only moves indices between the free and active lists. When rendering takes
+// more than cpuBudget of the block's real-time duration, the voice limit
+// backs off and then slowly recovers.
+class GrainEngine
+{
+public:
+    static constexpr int poolSize = 512;
+    static constexpr int chunkSize = 64;          // grains are rendered in chunks of at most this
+    static constexpr float maxPitchRatio = 4.0f;  // +24 semitones
+    static constexpr int windowTableSize = 512;
+    static constexpr double cpuBudget = 0.25;     // fraction of real time the grains may use
+
+    //==============================================================================
+    void prepare (double newSampleRate, int newNumChannels)
+    {
+        sampleRate = newSampleRate;
+        numChannels = juce::jmin (newNumChannels, 2);
+
+        grains.resize (poolSize);
+        activeList.resize (poolSize);
+        freeList.resize (poolSize);
+
+        // Hann window, one guard point for interpolation
+        window.resize (windowTableSize + 1);
+        for (int i = 0; i <= windowTableSize; ++i)
+            window[(size_t) i] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * (float) i / (float) windowTableSize);
+
+        reset();
+    }
+
+    void reset()
+    {
+        numActive = 0;
+        numFree = poolSize;
+        for (int i = 0; i < poolSize; ++i)
+            freeList[(size_t) i] = poolSize - 1 - i;
+
+        voiceLimit = poolSize;
+        samplesToNextGrain = 0.0;
+        blockTicks = 0;
+    }
+
+    void setParameters (float newDensityHz, float newSizeSeconds, float newPitchSemitones, float newSpray, float newTimeSeconds) noexcept
+    {
+        density = newDensityHz;
+        sizeSamples = juce::jmax (16.0f, newSizeSeconds * (float) sampleRate);
+        pitchRatio = juce::jlimit (1.0f / maxPitchRatio, maxPitchRatio, std::pow (2.0f, newPitchSemitones / 12.0f));
+        spray = newSpray;
+        timeSamples = newTimeSeconds * (float) sampleRate;
+    }
+
+    int getNumActiveGrains() const noexcept { return numActive; }
+    int getVoiceLimit() const noexcept      { return voiceLimit; }
+
+    //==============================================================================
+    // Adds the grains for the next numSamples into out. writePosition is where the
+    // memory will write this segment, so everything before it is history.
+    void process (const DelayMemory& memory, int writePosition, float* const* out, int numOutChannels, int numSamples)
+    {
+        auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int offset = 0; offset < numSamples; offset += chunkSize)
+        {
+            auto num = juce::jmin (chunkSize, numSamples - offset);
+            spawnGrains (memory, writePosition + offset, num);
+
+            float* chunkOut[2] = { out[0] + offset, numOutChannels > 1 ? out[1] + offset : nullptr };
+            renderChunk (memory, chunkOut, num);
+        }
+
+        blockTicks += juce::Time::getHighResolutionTicks() - startTicks;
+    }
+
+    // Call once per processBlock with the block's real-time duration.
+    void adaptVoices (double blockSeconds) noexcept
+    {
+        auto usedSeconds = juce::Time::highResolutionTicksToSeconds (blockTicks);
+        blockTicks = 0;
+
+        if (usedSeconds > blockSeconds * cpuBudget)
+            voiceLimit = juce::jmax (minVoices, (numActive * 3) / 4);
+        else if (voiceLimit < poolSize)
+            voiceLimit = juce::jmin (poolSize, voiceLimit + 4);
+    }
+
+private:
+    //==============================================================================
+    struct Grain
+    {
+        double position = 0.0;        // read position in memory samples
+        float increment = 1.0f;       // playback rate
+        float windowPhase = 0.0f;     // 0..1 over the grain
+        float windowIncrement = 0.0f;
+        float gain[2] = { 1.0f, 1.0f };
+        int startOffset = 0;          // samples into the next chunk before the grain starts
+    };
+
+    static constexpr int minVoices = 16;
+    static constexpr int maxSpan = (int) (chunkSize * maxPitchRatio) + 2;
+
+    void spawnGrains (const DelayMemory& memory, int writePosition, int numSamples)
+    {
+        if (density <= 0.0f)
+            return;
+
+        auto interval = sampleRate / density;
+        auto overlapGain = 1.0f / std::sqrt (1.0f + density * sizeSamples / (float) sampleRate);
+
+        while (samplesToNextGrain < numSamples)
+        {
+            auto onset = (int) samplesToNextGrain;
+            samplesToNextGrain += interval * (1.0 + 0.5 * spray * (random.nextDouble() - 0.5));
+
+            if (numActive >= voiceLimit || numFree == 0)
+                continue;
+
+            auto index = freeList[(size_t) --numFree];
+            activeList[(size_t) numActive++] = index;
+            auto& g = grains[(size_t) index];
+
+            // A faster-than-realtime grain must start far enough back not to overtake the write head
+            auto minDistance = sizeSamples * juce::jmax (0.0f, pitchRatio - 1.0f) + (float) (2 * chunkSize);
+            auto distance = juce::jmax (minDistance, timeSamples * (1.0f - spray * random.nextFloat()));
+            distance = juce::jmin (distance, (float) (memory.getLength() - 2 * chunkSize));
+
+            g.position = (double) memory.wrap (writePosition + onset - (int) distance);
+            g.increment = pitchRatio;
+            g.windowPhase = 0.0f;
+            g.windowIncrement = 1.0f / sizeSamples;
+            g.startOffset = onset;
+
+            auto pan = 0.5f + spray * (random.nextFloat() - 0.5f);
+            g.gain[0] = overlapGain * std::cos (pan * juce::MathConstants<float>::halfPi) * juce::MathConstants<float>::sqrt2;
+            g.gain[1] = overlapGain * std::sin (pan * juce::MathConstants<float>::halfPi) * juce::MathConstants<float>::sqrt2;
+        }
+
+        samplesToNextGrain -= numSamples;
+    }
+
+    void renderChunk (const DelayMemory& memory, float* const* out, int numSamples)
+    {
+        float span[maxSpan];
+        float windowed[chunkSize];
+        float samples[chunkSize];
+
+        for (int a = 0; a < numActive;)
+        {
+            auto& g = grains[(size_t) activeList[(size_t) a]];
+            auto start = g.startOffset;
+            g.startOffset = 0;
+
+            // Samples left in the grain, and in this chunk
+            auto remaining = (int) std::ceil ((1.0f - g.windowPhase) / g.windowIncrement);
+            auto num = juce::jmin (numSamples - start, remaining);
+
+            if (num > 0)
+            {
+                // Window from the lookup table
+                kernels.lookupTable (window.data(), windowTableSize, g.windowPhase, g.windowIncrement, windowed, num);
+
+                auto base = (int) std::floor (g.position);
+                auto frac0 = (float) (g.position - (double) base);
+                auto spanLength = juce::jmin (maxSpan, (int) (frac0 + g.increment * (float) num) + 2);
+
+                for (int ch = 0; ch < numChannels && out[ch] != nullptr; ++ch)
+                {
+                    memory.read (ch, base, span, spanLength);
+                    kernels.interpolate (span, frac0, g.increment, samples, num);
+
+                    juce::FloatVectorOperations::multiply (samples, g.gain[ch], num);
+                    juce::FloatVectorOperations::addWithMultiply (out[ch] + start, samples, windowed, num);
+                }
+
+                g.position = (double) memory.wrap (base) + (double) frac0 + (double) g.increment * num;
+                g.windowPhase += g.windowIncrement * (float) num;
+            }
+
+            if (num >= remaining)
+            {
+                // Finished: back to the pool, the last active grain takes this slot
+                freeList[(size_t) numFree++] = activeList[(size_t) a];
+                activeList[(size_t) a] = activeList[(size_t) --numActive];
+            }
+            else
+            {
+                ++a;
+            }
+        }
+    }
+
+    //==============================================================================
+    const DSPKernels& kernels = getDSPKernels();
+
+    double sampleRate = 44100.0;
+    int numChannels = 2;
+
+    std::vector<Grain> grains;
+    std::vector<int> activeList, freeList;
+    int numActive = 0, numFree = 0;
+    int voiceLimit = poolSize;
+
+    std::vector<float> window;
+    juce::Random random;
+
+    float density = 0.0f, sizeSamples = 4410.0f, pitchRatio = 1.0f, spray = 0.0f, timeSamples = 22050.0f;
+    double samplesToNextGrain = 0.0;
+    juce::int64 blockTicks = 0;
+};
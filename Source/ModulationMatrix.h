@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    ModulationMatrix.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Control-rate modulation matrix.
+// Sources (2 LFOs, envelope follower, macro) are evaluated once every
+// controlInterval samples; destinations read a linear ramp between the
+// previous and the current evaluation. Destinations flagged as audio rate
+// (e.g. Drown, which is a gain) get a per-sample offset buffer instead.
+class ModulationMatrix
+{
+public:
+    enum Source
+    {
+        sourceOff = 0,
+        sourceLfo1,
+        sourceLfo2,
+        sourceEnvelope,
+        sourceMacro,
+        numSources
+    };
+
+    enum Destination
+    {
+        destCorruption = 0,
+        destDrown,
+        destObscura,
+        destVoid,
+        destErosion,
+        destWhispers,
+        destTremor,
+        numDestinations
+    };
+
+    static constexpr int numSlots = 4;
+    static constexpr int minControlInterval = 16;
+    static constexpr int maxControlInterval = 64;
+
+    struct Slot
+    {
+        int source = sourceOff;
+        int destination = destCorruption;
+        float depth = 0.0f;
+    };
+
+    //==============================================================================
+    void prepare (double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        updateEnvelopeCoefficients();
+        reset();
+    }
+
+    void reset()
+    {
+        lfoPhase.fill (0.0f);
+        lfoStartPhase.fill (0.0f);
+        envelope = envelopeStart = 0.0f;
+        macroStart = macroEnd = macro;
+        computeOffsets (endOffsets, lfoPhase, envelope, macroEnd);
+        startOffsets = endOffsets;
+    }
+
+    //==============================================================================
+    void setControlInterval (int numSamples)
+    {
+        controlInterval = juce::jlimit (minControlInterval, maxControlInterval, numSamples);
+    }
+
+    int getControlInterval() const noexcept { return controlInterval; }
+
+    void setLfoRate (int index, float rateHz)
+    {
+        lfoIncrement[(size_t) index] = (float) (juce::MathConstants<double>::twoPi * rateHz / sampleRate);
+    }
+
+    void setMacro (float newValue) noexcept { macro = newValue; }
+
+    void setSlot (int index, int source, int destination, float depth) noexcept
+    {
+        auto& s = slots[(size_t) index];
+        s.source = source;
+        s.destination = destination;
+        s.depth = depth;
+    }
+
+    void setAudioRate (int destination, bool shouldRunAtAudioRate) noexcept
+    {
+        audioRate[(size_t) destination] = shouldRunAtAudioRate;
+    }
+
+    bool isModulated (int destination) const noexcept
+    {
+        for (const auto& s : slots)
+            if (s.source != sourceOff && s.destination == destination && s.depth != 0.0f)
+                return true;
+
+        return false;
+    }
+
+    bool isAudioRate (int destination) const noexcept
+    {
+        return audioRate[(size_t) destination] && isModulated (destination);
+    }
+
+    //==============================================================================
+    // Evaluates the sources at the end of the next control period of numSamples
+    // (<= controlInterval). inputPeak is the absolute peak of the input over that
+    // period and drives the envelope follower.
+    void advance (int numSamples, float inputPeak)
+    {
+        jassert (numSamples > 0 && numSamples <= maxControlInterval);
+
+        startOffsets = endOffsets;
+        lfoStartPhase = lfoPhase;
+        envelopeStart = envelope;
+        macroStart = macroEnd;
+        macroEnd = macro;
+
+        // Coefficients match the period length, so short periods (split blocks) don't track faster
+        const auto& coeffs = inputPeak > envelope ? attackCoeffs : releaseCoeffs;
+        envelope += (inputPeak - envelope) * coeffs[(size_t) numSamples];
+
+        for (size_t i = 0; i < lfoPhase.size(); ++i)
+        {
+            lfoPhase[i] += lfoIncrement[i] * (float) numSamples;
+            lfoPhase[i] = std::fmod (lfoPhase[i], juce::MathConstants<float>::twoPi);
+        }
+
+        computeOffsets (endOffsets, lfoPhase, envelope, macroEnd);
+
+        for (int d = 0; d < numDestinations; ++d)
+            if (isAudioRate (d))
+                renderAudioRate (d, numSamples);
+    }
+
+    // Offset at the start / end of the last control period, for linear ramps.
+    float getStartOffset (int destination) const noexcept { return startOffsets[(size_t) destination]; }
+    float getEndOffset   (int destination) const noexcept { return endOffsets[(size_t) destination]; }
+
+    // Per-sample offsets for the last control period; only valid if isAudioRate (destination).
+    const float* getAudioRateOffsets (int destination) const noexcept
+    {
+        return audioRateOffsets[(size_t) destination].data();
+    }
+
+private:
+    //==============================================================================
+    // One-pole coefficients for every period length the follower can be advanced by
+    void updateEnvelopeCoefficients()
+    {
+        for (int n = 0; n <= maxControlInterval; ++n)
+        {
+            auto periodSeconds = (double) n / sampleRate;
+            attackCoeffs[(size_t) n]  = (float) (1.0 - std::exp (-periodSeconds / 0.010)); // 10ms attack
+            releaseCoeffs[(size_t) n] = (float) (1.0 - std::exp (-periodSeconds / 0.150)); // 150ms release
+        }
+    }
+
+    float getSourceValue (int source, float lfo1, float lfo2, float env, float macroValue) const noexcept
+    {
+        switch (source)
+        {
+            case sourceLfo1:     return lfo1;
+            case sourceLfo2:     return lfo2;
+            case sourceEnvelope: return env;
+            case sourceMacro:    return macroValue;
+            default:             return 0.0f;
+        }
+    }
+
+    void computeOffsets (std::array<float, numDestinations>& dest, const std::array<float, 2>& phases,
+                         float env, float macroValue) const noexcept
+    {
+        auto lfo1 = std::sin (phases[0]);
+        auto lfo2 = std::sin (phases[1]);
+
+        dest.fill (0.0f);
+
+        for (const auto& s : slots)
+            if (s.source != sourceOff)
+                dest[(size_t) s.destination] += s.depth * getSourceValue (s.source, lfo1, lfo2, juce::jmin (env, 1.0f), macroValue);
+    }
+
+    void renderAudioRate (int destination, int numSamples) noexcept
+    {
+        auto* out = audioRateOffsets[(size_t) destination].data();
+        juce::FloatVectorOperations::clear (out, numSamples);
+
+        auto step = 1.0f / (float) numSamples;
+
+        for (const auto& s : slots)
+        {
+            if (s.source == sourceOff || s.destination != destination || s.depth == 0.0f)
+                continue;
+
+            if (s.source == sourceLfo1 || s.source == sourceLfo2)
+            {
+                auto index = (size_t) (s.source == sourceLfo1 ? 0 : 1);
+                auto phase = lfoStartPhase[index];
+                auto inc = lfoIncrement[index];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    phase += inc;
+                    out[i] += s.depth * std::sin (phase);
+                }
+            }
+            else
+            {
+                // Envelope and macro are slow: a linear ramp is exact enough.
+                auto start = s.source == sourceEnvelope ? juce::jmin (envelopeStart, 1.0f) : macroStart;
+                auto end   = s.source == sourceEnvelope ? juce::jmin (envelope, 1.0f)      : macroEnd;
+                auto inc = (end - start) * step;
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    start += inc;
+                    out[i] += s.depth * start;
+                }
+            }
+        }
+    }
+
+    //==============================================================================
+    double sampleRate = 44100.0;
+    int controlInterval = 32;
+
+    std::array<Slot, numSlots> slots;
+    std::array<bool, numDestinations> audioRate {};
+
+    std::array<float, 2> lfoPhase {}, lfoStartPhase {}, lfoIncrement {};
+    float envelope = 0.0f, envelopeStart = 0.0f;
+    std::array<float, maxControlInterval + 1> attackCoeffs {}, releaseCoeffs {};
+    float macro = 0.0f, macroStart = 0.0f, macroEnd = 0.0f;
+
+    std::array<float, numDestinations> startOffsets {}, endOffsets {};
+    std::array<std::array<float, maxControlInterval>, numDestinations> audioRateOffsets {};
+};
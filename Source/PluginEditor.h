@@ -13,26 +13,21 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "AbyssalLookAndFeel.h"
-
-struct Particle
-{
-    float x, y;
-    float angle;
-    float speed;
-    float alpha;
-    float size;
-};
+#include "EmberField.h"
 
 class VisualizerComponent : public juce::Component, public juce::Timer
 {
 public:
+    static constexpr int numEmbers = 50;
+    static constexpr double stepHz = 60.0;      // animation rate, independent of the timer's accuracy
+    static constexpr int maxStepsPerFrame = 4;  // after a stall, catch up this much and drop the rest
+
     VisualizerComponent(std::atomic<float>& rmsValue, std::atomic<float>* corruptionVal) 
         : currentRMS(rmsValue), corruptionParam(corruptionVal)
     {
+        embers.setNumEmbers(numEmbers);
+        lastTickMs = juce::Time::getMillisecondCounterHiRes();
         startTimerHz(60);
-        // Initialize particles
-        particles.resize(50); // 50 particles
-        for (auto& p : particles) resetParticle(p);
     }
 
     ~VisualizerComponent() override
@@ -40,72 +35,58 @@ public:
         stopTimer();
     }
 
-    void resetParticle(Particle& p)
-    {
-        auto bounds = getLocalBounds().toFloat();
-        auto center = bounds.getCentre();
-        p.x = center.x;
-        p.y = center.y;
-        p.angle = juce::Random::getSystemRandom().nextFloat() * juce::MathConstants<float>::twoPi;
-        p.speed = 1.0f + juce::Random::getSystemRandom().nextFloat() * 2.0f;
-        p.alpha = 1.0f;
-        p.size = 1.0f + juce::Random::getSystemRandom().nextFloat() * 3.0f;
-    }
-
     void timerCallback() override
     {
-        // Smooth the RMS value
-        float target = currentRMS.load();
-        
-        // Transient Detection for Shockwave
-        if (target > lastRMS + 0.15f) // Threshold for transient
-        {
-            shockwaveRadius = 0.0f;
-            shockwaveAlpha = 1.0f;
-        }
-        lastRMS = target;
-        
-        smoothedRMS += (target - smoothedRMS) * 0.1f; // Simple smoothing
-        
-        // Update Shockwave
-        if (shockwaveAlpha > 0.0f)
+        // Fixed timestep: motion speed doesn't depend on when the timer fires
+        const double stepMs = 1000.0 / stepHz;
+        auto now = juce::Time::getMillisecondCounterHiRes();
+        pendingMs = juce::jmin(pendingMs + (now - lastTickMs), maxStepsPerFrame * stepMs);
+        lastTickMs = now;
+
+        bool stepped = false;
+        while (pendingMs >= stepMs)
         {
-            shockwaveRadius += 10.0f; // Expand speed
-            shockwaveAlpha -= 0.05f;  // Fade speed
-            if (shockwaveAlpha < 0.0f) shockwaveAlpha = 0.0f;
+            pendingMs -= stepMs;
+            advance();
+            stepped = true;
         }
-        
-        // Update Particles
-        for (auto& p : particles)
+
+        if (stepped)
         {
-            p.x += std::cos(p.angle) * p.speed * (1.0f + smoothedRMS * 5.0f); // Speed up with volume
-            p.y += std::sin(p.angle) * p.speed * (1.0f + smoothedRMS * 5.0f);
-            p.alpha -= 0.02f;
-            
-            if (p.alpha <= 0.0f)
+            // Only what moved: each ember's old and new sprite, and the core and
+            // shockwave when they look different from last time
+            renderEmbers();
+
+            const CoreLook look { getCoreRadius(), getCorruption(), shockwaveRadius, shockwaveAlpha };
+
+            if (look != lastCoreLook)
             {
-                resetParticle(p);
+                auto coreArea = getCoreArea();
+                repaint(coreArea.getUnion(lastCoreArea));
+                lastCoreArea = coreArea;
+                lastCoreLook = look;
             }
         }
-        
-        repaint();
+    }
+
+    void resized() override
+    {
+        // Ember coverage layer, drawn with the current colour as one blit
+        emberLayer = juce::Image(juce::Image::SingleChannel, juce::jmax(1, getWidth()), juce::jmax(1, getHeight()),
+                                 true, juce::SoftwareImageType());
+        renderEmbers();
+        lastCoreArea = getLocalBounds();
+        lastCoreLook = {};
     }
 
     void paint(juce::Graphics& g) override
     {
         auto bounds = getLocalBounds().toFloat();
         auto center = bounds.getCentre();
-        
-        // Enhanced Dynamics (V0.5)
-        float sensitivity = std::sqrt(smoothedRMS); 
-        
-        // Dynamic Radius
-        float minRadius = juce::jmin(bounds.getWidth(), bounds.getHeight()) * 0.20f; 
-        float maxRadius = juce::jmin(bounds.getWidth(), bounds.getHeight()) * 0.55f;
-        float currentRadius = minRadius + (maxRadius - minRadius) * sensitivity;
+        float currentRadius = getCoreRadius();
         
         // Color Logic (V0.6): Cold vs Hot based on Corruption
-        float corruption = (corruptionParam != nullptr) ? corruptionParam->load() : 0.0f;
+        float corruption = getCorruption();
         
         juce::Colour coldCore = juce::Colours::cyan;
         juce::Colour coldMid  = juce::Colours::blue;
@@ -140,11 +121,15 @@ public:
             g.drawEllipse(center.x - shockwaveRadius, center.y - shockwaveRadius, shockwaveRadius * 2.0f, shockwaveRadius * 2.0f, 4.0f);
         }
         
-        // 3. Draw Particles (NEW)
-        for (const auto& p : particles)
+        // 3. Draw Embers (the part of the layer they cover that we're asked to paint)
+        auto drawn = embers.getDrawnArea();
+        auto emberArea = g.getClipBounds().getIntersection({ drawn.left, drawn.top, drawn.right - drawn.left, drawn.bottom - drawn.top });
+
+        if (! emberArea.isEmpty())
         {
-            g.setColour(midColor.withAlpha(p.alpha));
-            g.fillEllipse(p.x - p.size / 2.0f, p.y - p.size / 2.0f, p.size, p.size);
+            g.setColour(midColor);
+            g.drawImage(emberLayer, emberArea.getX(), emberArea.getY(), emberArea.getWidth(), emberArea.getHeight(),
+                        emberArea.getX(), emberArea.getY(), emberArea.getWidth(), emberArea.getHeight(), true);
         }
     }
 
@@ -154,10 +139,100 @@ private:
     float smoothedRMS = 0.0f;
     
     // V0.7 Additions
-    std::vector<Particle> particles;
     float shockwaveRadius = 0.0f;
     float shockwaveAlpha = 0.0f;
     float lastRMS = 0.0f;
+
+    // Embers
+    EmberField embers;
+    juce::Image emberLayer { juce::Image::SingleChannel, 1, 1, true, juce::SoftwareImageType() };
+    juce::Rectangle<int> lastCoreArea;
+
+    struct CoreLook
+    {
+        float radius = -1.0f, corruption = 0.0f, shockwaveRadius = 0.0f, shockwaveAlpha = 0.0f;
+
+        bool operator!= (const CoreLook& other) const
+        {
+            return radius != other.radius || corruption != other.corruption
+                || shockwaveRadius != other.shockwaveRadius || shockwaveAlpha != other.shockwaveAlpha;
+        }
+    };
+
+    CoreLook lastCoreLook;
+    double lastTickMs = 0.0;
+    double pendingMs = 0.0;
+
+    // Dynamic Radius (V0.5): grows with the square root of the level
+    float getCoreRadius() const
+    {
+        auto size = (float) juce::jmin(getWidth(), getHeight());
+        float minRadius = size * 0.20f;
+        float maxRadius = size * 0.55f;
+        return minRadius + (maxRadius - minRadius) * std::sqrt(smoothedRMS);
+    }
+
+    float getCorruption() const
+    {
+        return (corruptionParam != nullptr) ? corruptionParam->load() : 0.0f;
+    }
+
+    // What paint() covers besides the embers: the core and the shockwave ring
+    juce::Rectangle<int> getCoreArea() const
+    {
+        auto center = getLocalBounds().toFloat().getCentre();
+        auto radius = getCoreRadius();
+
+        if (shockwaveAlpha > 0.0f)
+            radius = juce::jmax(radius, shockwaveRadius + 3.0f); // 4px stroke, plus antialiasing
+
+        return juce::Rectangle<float>(radius * 2.0f, radius * 2.0f).withCentre(center)
+                   .getSmallestIntegerContainer().getIntersection(getLocalBounds());
+    }
+
+    // Draws the embers into the layer and repaints the areas that changed
+    void renderEmbers()
+    {
+        auto center = getLocalBounds().toFloat().getCentre();
+
+        {
+            juce::Image::BitmapData data(emberLayer, juce::Image::BitmapData::readWrite);
+            embers.render(data.data, data.width, data.height, data.lineStride, center.x, center.y);
+        }
+
+        embers.forEachChangedArea([this](const EmberField::Bounds& area)
+        {
+            repaint(area.left, area.top, area.right - area.left, area.bottom - area.top);
+        });
+    }
+
+    // One animation step
+    void advance()
+    {
+        // Smooth the RMS value
+        float target = currentRMS.load();
+        
+        // Transient Detection for Shockwave
+        if (target > lastRMS + 0.15f) // Threshold for transient
+        {
+            shockwaveRadius = 0.0f;
+            shockwaveAlpha = 1.0f;
+        }
+        lastRMS = target;
+        
+        smoothedRMS += (target - smoothedRMS) * 0.1f; // Simple smoothing
+        
+        // Update Shockwave
+        if (shockwaveAlpha > 0.0f)
+        {
+            shockwaveRadius += 10.0f; // Expand speed
+            shockwaveAlpha -= 0.05f;  // Fade speed
+            if (shockwaveAlpha < 0.0f) shockwaveAlpha = 0.0f;
+        }
+        
+        // Update Embers (speed up with volume)
+        embers.step(1.0f + smoothedRMS * 5.0f);
+    }
 };
 
 class AbyssalGazeNewAudioProcessorEditor  : public juce::AudioProcessorEditor
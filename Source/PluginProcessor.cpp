@@ -20,6 +20,40 @@ const juce::String AbyssalGazeNewAudioProcessor::id_erosion    = "erosion";
 const juce::String AbyssalGazeNewAudioProcessor::id_whispers   = "whispers";
 const juce::String AbyssalGazeNewAudioProcessor::id_tremor     = "tremor";
 const juce::String AbyssalGazeNewAudioProcessor::id_revelation = "revelation";
+const juce::String AbyssalGazeNewAudioProcessor::id_voidReducedRate = "voidReducedRate";
+
+const juce::String AbyssalGazeNewAudioProcessor::id_whispersTime   = "whispersTime";
+const juce::String AbyssalGazeNewAudioProcessor::id_whispersFreeze = "whispersFreeze";
+const juce::String AbyssalGazeNewAudioProcessor::id_whispersMemory = "whispersMemory";
+const juce::String AbyssalGazeNewAudioProcessor::id_whispersMode   = "whispersMode";
+const juce::String AbyssalGazeNewAudioProcessor::id_grainDensity   = "grainDensity";
+const juce::String AbyssalGazeNewAudioProcessor::id_grainSize      = "grainSize";
+const juce::String AbyssalGazeNewAudioProcessor::id_grainPitch     = "grainPitch";
+const juce::String AbyssalGazeNewAudioProcessor::id_grainSpray     = "grainSpray";
+
+const juce::String AbyssalGazeNewAudioProcessor::id_lfo1Rate   = "lfo1Rate";
+const juce::String AbyssalGazeNewAudioProcessor::id_lfo2Rate   = "lfo2Rate";
+const juce::String AbyssalGazeNewAudioProcessor::id_macro      = "macro";
+const juce::String AbyssalGazeNewAudioProcessor::id_modRate    = "modRate";
+
+juce::String AbyssalGazeNewAudioProcessor::getModSlotID (int slot, const juce::String& field)
+{
+    return "mod" + juce::String (slot + 1) + field; // e.g. "mod1Source"
+}
+
+// Control intervals selectable by id_modRate (samples)
+static const int modControlIntervals[] = { 16, 32, 64 };
+
+// The seven knobs, in ModulationMatrix::Destination order
+static const juce::String* const destinationIDs[] = {
+    &AbyssalGazeNewAudioProcessor::id_corruption,
+    &AbyssalGazeNewAudioProcessor::id_drown,
+    &AbyssalGazeNewAudioProcessor::id_obscura,
+    &AbyssalGazeNewAudioProcessor::id_void,
+    &AbyssalGazeNewAudioProcessor::id_erosion,
+    &AbyssalGazeNewAudioProcessor::id_whispers,
+    &AbyssalGazeNewAudioProcessor::id_tremor
+};
 
 // Preset Data Table
 struct PresetData {
@@ -54,12 +88,53 @@ AbyssalGazeNewAudioProcessor::AbyssalGazeNewAudioProcessor()
 #endif
        apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
+    weakThis = this;
+
     apvts.addParameterListener(id_revelation, this);
+    apvts.addParameterListener(id_whispersMemory, this);
+    apvts.addParameterListener(id_voidReducedRate, this);
+
+    voidReducedRateParam = apvts.getRawParameterValue(id_voidReducedRate);
+    whispersTimeParam   = apvts.getRawParameterValue(id_whispersTime);
+    whispersFreezeParam = apvts.getRawParameterValue(id_whispersFreeze);
+    whispersMemoryParam = apvts.getRawParameterValue(id_whispersMemory);
+    whispersModeParam   = apvts.getRawParameterValue(id_whispersMode);
+    grainDensityParam   = apvts.getRawParameterValue(id_grainDensity);
+    grainSizeParam      = apvts.getRawParameterValue(id_grainSize);
+    grainPitchParam     = apvts.getRawParameterValue(id_grainPitch);
+    grainSprayParam     = apvts.getRawParameterValue(id_grainSpray);
+
+    for (int d = 0; d < ModulationMatrix::numDestinations; ++d)
+    {
+        destinationParams[(size_t) d] = apvts.getRawParameterValue(*destinationIDs[d]);
+        apvts.addParameterListener(*destinationIDs[d], this);
+    }
+
+    lfo1RateParam = apvts.getRawParameterValue(id_lfo1Rate);
+    lfo2RateParam = apvts.getRawParameterValue(id_lfo2Rate);
+    macroParam    = apvts.getRawParameterValue(id_macro);
+    modRateParam  = apvts.getRawParameterValue(id_modRate);
+
+    for (int slot = 0; slot < ModulationMatrix::numSlots; ++slot)
+    {
+        auto& slotParams = modSlotParams[(size_t) slot];
+        slotParams.source      = apvts.getRawParameterValue(getModSlotID(slot, "Source"));
+        slotParams.destination = apvts.getRawParameterValue(getModSlotID(slot, "Dest"));
+        slotParams.depth       = apvts.getRawParameterValue(getModSlotID(slot, "Depth"));
+    }
+
+    // Drown is a gain: it zippers if it is only updated at control rate
+    modMatrix.setAudioRate(ModulationMatrix::destDrown, true);
 }
 
 AbyssalGazeNewAudioProcessor::~AbyssalGazeNewAudioProcessor()
 {
     apvts.removeParameterListener(id_revelation, this);
+    apvts.removeParameterListener(id_whispersMemory, this);
+    apvts.removeParameterListener(id_voidReducedRate, this);
+
+    for (auto* id : destinationIDs)
+        apvts.removeParameterListener(*id, this);
 }
 
 //==============================================================================
@@ -89,6 +164,43 @@ juce::AudioProcessorValueTreeState::ParameterLayout AbyssalGazeNewAudioProcessor
 
     layout.add(std::make_unique<juce::AudioParameterChoice>(id_revelation, "Revelation", presetNames, 0));
 
+    // Above 48kHz, run the reverb near 48kHz (adds a little latency)
+    layout.add(std::make_unique<juce::AudioParameterBool>(id_voidReducedRate, "VOID Reduced Rate", true));
+
+    // Whispers
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_whispersTime, "Whispers Time",
+                                                           juce::NormalisableRange<float>(0.01f, (float) maxDelaySeconds, 0.0f, 0.25f), 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterBool>(id_whispersFreeze, "Whispers Freeze", false));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(id_whispersMemory, "Whispers Memory",
+                                                            juce::StringArray { "32-bit Float", "16-bit Half", "16-bit Int", "64-bit Double" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(id_whispersMode, "Whispers Mode",
+                                                            juce::StringArray { "Echo", "Granular" }, 0));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_grainDensity, "Grain Density",
+                                                           juce::NormalisableRange<float>(1.0f, 1000.0f, 0.0f, 0.3f), 40.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_grainSize, "Grain Size",
+                                                           juce::NormalisableRange<float>(0.01f, 0.5f, 0.0f, 0.5f), 0.1f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_grainPitch, "Grain Pitch", -24.0f, 24.0f, 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_grainSpray, "Grain Spray", 0.0f, 1.0f, 0.3f));
+
+    // Modulation Matrix
+    juce::NormalisableRange<float> lfoRange(0.05f, 20.0f, 0.0f, 0.3f);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_lfo1Rate, "LFO 1 Rate", lfoRange, 0.5f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_lfo2Rate, "LFO 2 Rate", lfoRange, 3.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(id_macro,    "Macro",      0.0f, 1.0f, 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(id_modRate, "Mod Rate",
+                                                            juce::StringArray { "16 Samples", "32 Samples", "64 Samples" }, 1));
+
+    juce::StringArray sourceNames { "Off", "LFO 1", "LFO 2", "Envelope", "Macro" };
+    juce::StringArray destinationNames { "Corruption", "Drown", "Obscura", "VOID", "Erosion", "Whispers", "Tremor" };
+
+    for (int slot = 0; slot < ModulationMatrix::numSlots; ++slot)
+    {
+        auto name = "Mod " + juce::String(slot + 1) + " ";
+        layout.add(std::make_unique<juce::AudioParameterChoice>(getModSlotID(slot, "Source"), name + "Source", sourceNames, 0));
+        layout.add(std::make_unique<juce::AudioParameterChoice>(getModSlotID(slot, "Dest"),   name + "Destination", destinationNames, 0));
+        layout.add(std::make_unique<juce::AudioParameterFloat>(getModSlotID(slot, "Depth"),   name + "Depth", -1.0f, 1.0f, 0.0f));
+    }
+
     return layout;
 }
 
@@ -98,16 +210,36 @@ void AbyssalGazeNewAudioProcessor::parameterChanged(const juce::String& paramete
     {
         updatePresets((int)newValue);
     }
+    else if (parameterID == id_whispersMemory)
+    {
+        // Changing the storage format reallocates, keep that off the audio thread
+        juce::MessageManager::callAsync([processor = weakThis]() { if (processor != nullptr) processor->prepareDelayMemory(); });
+    }
+    else if (parameterID == id_voidReducedRate)
+    {
+        // Reprepares the reverb and changes the latency, message thread only
+        juce::MessageManager::callAsync([processor = weakThis]() { if (processor != nullptr) processor->prepareVoid(); });
+    }
+    else if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        // Knob moves made on the message thread (editor, hosts automating from it) are timestamped
+        // and placed at the same point of the next block. Host automation delivered with the block
+        // (audio thread) has no offset, SubBlockAutomation ramps it across the block instead.
+        for (int d = 0; d < ModulationMatrix::numDestinations; ++d)
+        {
+            if (parameterID == *destinationIDs[d])
+            {
+                const auto ticks = juce::Time::getHighResolutionTicks();
+                knobChangeFifo.write(1).forEach([&](int index) { knobChanges[(size_t) index] = { d, newValue, ticks }; });
+                break;
+            }
+        }
+    }
 }
 
 void AbyssalGazeNewAudioProcessor::updatePresets(int presetIndex)
 {
-    if (presetIndex < 0 || presetIndex >= 10) return;
-
-    const auto& data = presets[presetIndex];
-
-    // Map 1-10 to 0.0-1.0
-    auto mapVal = [](int val) { return (float)(val - 1) / 9.0f; };
+    if (presetIndex < 0 || presetIndex >= numPresets) return;
 
     // We need to set the parameters on the message thread or via a safe mechanism if this is called from audio thread.
     // parameterChanged can be called from audio thread. However, setValueNotifyingHost is not safe on audio thread usually.
@@ -118,21 +250,30 @@ void AbyssalGazeNewAudioProcessor::updatePresets(int presetIndex)
     // But here we are setting OTHER parameters based on one.
     
     // We will use callAsync to update parameters on the message thread to be safe and update UI.
-    juce::MessageManager::callAsync([this, data, mapVal]()
-    {
-        auto setParam = [&](const juce::String& id, int val) {
-            auto* param = apvts.getParameter(id);
-            if (param) param->setValueNotifyingHost(mapVal(val));
-        };
-
-        setParam(id_corruption, data.corruption);
-        setParam(id_drown,      data.drown);
-        setParam(id_obscura,    data.obscura);
-        setParam(id_void,       data.voidVal);
-        setParam(id_erosion,    data.erosion);
-        setParam(id_whispers,   data.whispers);
-        setParam(id_tremor,     data.tremor);
-    });
+    juce::MessageManager::callAsync([processor = weakThis, presetIndex]() { if (processor != nullptr) processor->applyPreset(presetIndex); });
+}
+
+void AbyssalGazeNewAudioProcessor::applyPreset(int presetIndex)
+{
+    if (presetIndex < 0 || presetIndex >= numPresets) return;
+
+    const auto& data = presets[presetIndex];
+
+    // Map 1-10 to 0.0-1.0
+    auto mapVal = [](int val) { return (float)(val - 1) / 9.0f; };
+
+    auto setParam = [&](const juce::String& id, int val) {
+        auto* param = apvts.getParameter(id);
+        if (param) param->setValueNotifyingHost(mapVal(val));
+    };
+
+    setParam(id_corruption, data.corruption);
+    setParam(id_drown,      data.drown);
+    setParam(id_obscura,    data.obscura);
+    setParam(id_void,       data.voidVal);
+    setParam(id_erosion,    data.erosion);
+    setParam(id_whispers,   data.whispers);
+    setParam(id_tremor,     data.tremor);
 }
 
 //==============================================================================
@@ -143,19 +284,128 @@ void AbyssalGazeNewAudioProcessor::prepareToPlay (double sampleRate, int samples
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
 
-    filter.prepare(spec);
-    filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    auto prepareChain = [&](auto& chain)
+    {
+        chain.filter.prepare(spec);
+        chain.filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+        chain.dryBuffer.setSize(getTotalNumOutputChannels(), ModulationMatrix::maxControlInterval);
+        chain.tremoloPhase = 0;
+    };
+    prepareChain(floatChain);
+    prepareChain(doubleChain);
     
-    reverb.prepare(spec);
     reverbParams.roomSize = 0.5f;
     reverbParams.damping = 0.5f;
-    reverb.setParameters(reverbParams);
+    prepareVoid();
+
+    prepareDelayMemory();
+    grainEngine.prepare(sampleRate, getTotalNumOutputChannels());
+
+    knobChangeFifo.reset(); // changes made while stopped are already in the parameter values
+    lastBlockTicks = juce::Time::getHighResolutionTicks();
 
-    delayBuffer.setSize(getTotalNumOutputChannels(), (int)(2.0 * sampleRate)); // 2 seconds max delay
-    delayBuffer.clear();
+    modMatrix.prepare(sampleRate);
+    updateModulationMatrix();
+    modMatrix.reset(); // start from the current routing
+
+    float currentValues[ModulationMatrix::numDestinations];
+    for (int d = 0; d < ModulationMatrix::numDestinations; ++d)
+        currentValues[d] = destinationParams[(size_t) d]->load();
+    automation.reset(currentValues);
+}
+
+void AbyssalGazeNewAudioProcessor::automateParameter (int destination, int sampleOffset, float value)
+{
+    automation.addEvent(sampleOffset, destination, value);
+}
+
+void AbyssalGazeNewAudioProcessor::prepareDelayMemory()
+{
+    if (getSampleRate() <= 0.0)
+        return;
+
+    auto format = (DelayMemory::Format) juce::jlimit(0, (int) DelayMemory::numFormats - 1, (int) whispersMemoryParam->load());
+
+    // Allocate outside the callback lock (30s of stereo can be 20MB+), only the swap blocks the audio thread.
+    // The old memory is freed when newMemory goes out of scope, after the lock is released.
+    DelayMemory newMemory;
+    newMemory.prepare(getTotalNumOutputChannels(), (int) std::ceil(maxDelaySeconds * getSampleRate()) + 1, format);
+
+    const juce::ScopedLock sl(getCallbackLock());
+    delayMemory.swap(newMemory);
     delayWritePosition = 0;
+}
+
+void AbyssalGazeNewAudioProcessor::prepareVoid()
+{
+    if (getSampleRate() <= 0.0)
+        return;
+
+    const int numChannels = getTotalNumOutputChannels();
+    const int blockSize = juce::jmax(1, getBlockSize());
+    const bool reduce = voidReducedRateParam->load() >= 0.5f;
 
-    tremoloPhase = 0.0f;
+    // The resampler, the combs and the delays all allocate: build new stages outside the
+    // callback lock, the audio thread only waits for the swaps.
+    // Same filters at both precisions, so the latency doesn't depend on the host's choice.
+    int latency = 0;
+    bool reduced = false;
+
+    auto buildStage = [&](auto& stage)
+    {
+        stage.rateReducer.prepare(getSampleRate(), numChannels, ModulationMatrix::maxControlInterval);
+        reduced = reduce && stage.rateReducer.getFactor() > 1;
+        latency = reduced ? stage.rateReducer.getLatencySamples() : 0;
+
+        juce::dsp::ProcessSpec spec;
+        spec.sampleRate = reduced ? stage.rateReducer.getInternalRate() : getSampleRate();
+        spec.maximumBlockSize = (juce::uint32) blockSize;
+        spec.numChannels = (juce::uint32) numChannels;
+
+        stage.reverb.prepare(spec);
+
+        spec.sampleRate = getSampleRate();
+        for (auto* delay : { &stage.bypassDelay, &stage.dryDelay })
+        {
+            delay->setMaximumDelayInSamples(juce::jmax(1, latency));
+            delay->prepare(spec);
+            delay->setDelay((float) latency);
+        }
+    };
+
+    ChainState<float>::VoidStage floatStage;
+    ChainState<double>::VoidStage doubleStage;
+    buildStage(floatStage);
+    buildStage(doubleStage);
+
+    {
+        // The old stages are freed when these go out of scope, after the lock is released
+        const juce::ScopedLock sl(getCallbackLock());
+        std::swap(floatChain.voidStage, floatStage);
+        std::swap(doubleChain.voidStage, doubleStage);
+
+        // reverbParams belongs to the audio thread
+        floatChain.voidStage.reverb.setParameters(reverbParams);
+        doubleChain.voidStage.reverb.setParameters(reverbParams);
+        voidReduced = reduced;
+    }
+
+    setLatencySamples(latency);
+}
+
+void AbyssalGazeNewAudioProcessor::updateModulationMatrix()
+{
+    // Called from the audio thread: only cached parameter pointers in here
+    modMatrix.setLfoRate(0, lfo1RateParam->load());
+    modMatrix.setLfoRate(1, lfo2RateParam->load());
+    modMatrix.setMacro(macroParam->load());
+    modMatrix.setControlInterval(modControlIntervals[juce::jlimit(0, 2, (int) modRateParam->load())]);
+
+    for (int slot = 0; slot < ModulationMatrix::numSlots; ++slot)
+    {
+        const auto& slotParams = modSlotParams[(size_t) slot];
+        modMatrix.setSlot(slot, (int) slotParams.source->load(), (int) slotParams.destination->load(), slotParams.depth->load());
+    }
 }
 
 void AbyssalGazeNewAudioProcessor::releaseResources()
@@ -174,81 +424,177 @@ bool AbyssalGazeNewAudioProcessor::isBusesLayoutSupported (const BusesLayout& la
     return true;
 }
 
-void AbyssalGazeNewAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+void AbyssalGazeNewAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processChain(buffer);
+}
+
+void AbyssalGazeNewAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    processChain(buffer);
+}
+
+template <typename SampleType>
+void AbyssalGazeNewAudioProcessor::processChain (juce::AudioBuffer<SampleType>& buffer)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
+    int numSamples = buffer.getNumSamples();
+
+    // Nothing to place knob changes in: leave them queued for the next block
+    if (numSamples == 0)
+        return;
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+        buffer.clear (i, 0, numSamples);
 
-    // Get Parameters
-    float corruptionVal = *apvts.getRawParameterValue(id_corruption); // Distortion
-    float drownVal      = *apvts.getRawParameterValue(id_drown);      // Dry/Wet
-    float obscuraVal    = *apvts.getRawParameterValue(id_obscura);    // Filter Cutoff (1=Bright/Open, 0=Dark/Closed)
-    float voidVal       = *apvts.getRawParameterValue(id_void);       // Reverb Size
-    float erosionVal    = *apvts.getRawParameterValue(id_erosion);    // Bitcrush
-    float whispersVal   = *apvts.getRawParameterValue(id_whispers);   // Delay Feedback
-    float tremorVal     = *apvts.getRawParameterValue(id_tremor);     // Tremolo Rate
+    // Get Parameters (base values, modulation is added per segment).
+    // The wrappers only give us the last host value of the block, so the automation
+    // ramps to it across the block instead of jumping at the block boundary.
+    float targetValues[ModulationMatrix::numDestinations];
+    for (int d = 0; d < ModulationMatrix::numDestinations; ++d)
+        targetValues[d] = destinationParams[(size_t) d]->load();
+
+    // Message-thread knob changes since the last block land at the same relative
+    // position in this one: one block late, but with their timing kept
+    const auto blockTicks = juce::Time::getHighResolutionTicks();
+    const auto elapsedTicks = (double) juce::jmax((juce::int64) 1, blockTicks - lastBlockTicks);
+
+    knobChangeFifo.read(knobChangeFifo.getNumReady()).forEach([&](int index)
+    {
+        const auto& change = knobChanges[(size_t) index];
+        auto offset = (int) ((double) (change.ticks - lastBlockTicks) / elapsedTicks * numSamples);
+        automateParameter(change.destination, juce::jlimit(0, juce::jmax(0, numSamples - 1), offset), change.value);
+    });
+    lastBlockTicks = blockTicks;
+
+    automation.beginBlock(targetValues, numSamples);
+
+    updateModulationMatrix();
+
+    grainEngine.setParameters(grainDensityParam->load(), grainSizeParam->load(), grainPitchParam->load(),
+                              grainSprayParam->load(), whispersTimeParam->load());
 
     // Chain: Input -> [Corruption] -> [Obscura] -> [Erosion] -> [Tremor] -> [Whispers] -> [VOID] -> [Drown] -> Output
-    
-    // We need a dry buffer for the final mix
-    juce::AudioBuffer<float> dryBuffer;
-    dryBuffer.makeCopyOf(buffer);
+    auto& dryBuffer = getChain<SampleType>().dryBuffer;
+    const int numDryChannels = juce::jmin(buffer.getNumChannels(), dryBuffer.getNumChannels());
+    jassert(numDryChannels == buffer.getNumChannels());
 
-    auto* channelDataL = buffer.getWritePointer(0);
-    auto* channelDataR = totalNumOutputChannels > 1 ? buffer.getWritePointer(1) : nullptr;
-    int numSamples = buffer.getNumSamples();
+    // Run the chain in control-rate segments so the modulation matrix stays cheap.
+    // Segments are also split at automation change points (see SubBlockAutomation).
+    const int controlInterval = modMatrix.getControlInterval();
+    float baseStart[ModulationMatrix::numDestinations];
+    float baseEnd[ModulationMatrix::numDestinations];
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int end = automation.getSubBlockEnd(start, controlInterval);
+        const int num = end - start;
+
+        automation.getValues(start, true, baseStart);
+        automation.getValues(end, false, baseEnd);
+
+        // Dry copy of this segment for the envelope follower and the Drown mix.
+        // Segments never exceed maxControlInterval, whatever the host block size.
+        jassert(num <= dryBuffer.getNumSamples());
+        for (int ch = 0; ch < numDryChannels; ++ch)
+            dryBuffer.copyFrom(ch, 0, buffer, ch, start, num);
+
+        float peak = 0.0f;
+        for (int ch = 0; ch < totalNumInputChannels; ++ch)
+            peak = juce::jmax(peak, (float) dryBuffer.getMagnitude(ch, 0, num));
+
+        modMatrix.advance(num, peak);
+        processSegment(buffer, start, num, baseStart, baseEnd);
+        start = end;
+    }
+
+    automation.endBlock();
+
+    // Back off / recover grain voices against the CPU budget
+    grainEngine.adaptVoices((double) numSamples / getSampleRate());
+
+    // Calculate RMS for Visualizer
+    float rms = (float) buffer.getRMSLevel(0, 0, numSamples);
+    if (totalNumOutputChannels > 1)
+    {
+        rms = juce::jmax(rms, (float) buffer.getRMSLevel(1, 0, numSamples));
+    }
+    currentRMS.store(rms);
+}
+
+template <typename SampleType>
+void AbyssalGazeNewAudioProcessor::processSegment (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                                   const float* baseStart, const float* baseEnd)
+{
+    auto& chain = getChain<SampleType>();
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    auto* channelDataL = buffer.getWritePointer(0, startSample);
+    auto* channelDataR = totalNumOutputChannels > 1 ? buffer.getWritePointer(1, startSample) : nullptr;
     double sampleRate = getSampleRate();
 
+    // Modulated value of a destination at the start / end of this segment
+    auto startValue = [&](int d) { return juce::jlimit(0.0f, 1.0f, baseStart[d] + modMatrix.getStartOffset(d)); };
+    auto endValue   = [&](int d) { return juce::jlimit(0.0f, 1.0f, baseEnd[d] + modMatrix.getEndOffset(d)); };
+    const SampleType rampStep = (SampleType) 1 / (SampleType)numSamples;
+
     // 1. Corruption (Distortion)
     // Simple hard clipping / tanh
-    if (corruptionVal > 0.0f)
+    SampleType corruptionStart = startValue(ModulationMatrix::destCorruption);
+    SampleType corruptionEnd   = endValue(ModulationMatrix::destCorruption);
+    if (corruptionStart > 0 || corruptionEnd > 0)
     {
-        float drive = 1.0f + corruptionVal * 10.0f;
-        for (int i = 0; i < numSamples; ++i)
-        {
-            channelDataL[i] = std::tanh(channelDataL[i] * drive);
-            if (channelDataR) channelDataR[i] = std::tanh(channelDataR[i] * drive);
-        }
+        SampleType drive = 1 + corruptionStart * 10;
+        SampleType driveInc = (corruptionEnd - corruptionStart) * 10 * rampStep;
+        saturate(kernels, channelDataL, numSamples, drive, driveInc);
+        if (channelDataR) saturate(kernels, channelDataR, numSamples, drive, driveInc);
     }
 
     // 2. Obscura (Filter)
     // Map 0.0-1.0 to 20Hz-20000Hz
     // User req: 1 = Open/Bright, 0 = Closed/Dark. So 1.0 -> 20kHz, 0.0 -> 20Hz
-    float cutoff = 20.0f * std::pow(1000.0f, obscuraVal); 
-    filter.setCutoffFrequency(cutoff);
+    // Cutoff is a coefficient update, so it moves once per segment
+    float cutoff = 20.0f * std::pow(1000.0f, endValue(ModulationMatrix::destObscura));
+    chain.filter.setCutoffFrequency((SampleType) cutoff);
     
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    filter.process(context);
+    juce::dsp::AudioBlock<SampleType> block(buffer);
+    auto segmentBlock = block.getSubBlock((size_t)startSample, (size_t)numSamples);
+    juce::dsp::ProcessContextReplacing<SampleType> context(segmentBlock);
+    chain.filter.process(context);
 
     // 3. Erosion (Bitcrush)
-    if (erosionVal > 0.0f)
+    SampleType erosionStart = startValue(ModulationMatrix::destErosion);
+    SampleType erosionEnd   = endValue(ModulationMatrix::destErosion);
+    if (erosionStart > 0 || erosionEnd > 0)
     {
-        float crush = 1.0f - erosionVal * 0.9f; // 1.0 to 0.1
         // Simple quantization
-        float steps = 4.0f + (1.0f - erosionVal) * 60.0f; // 4 to 64 steps
-        for (int i = 0; i < numSamples; ++i)
-        {
-            channelDataL[i] = std::round(channelDataL[i] * steps) / steps;
-            if (channelDataR) channelDataR[i] = std::round(channelDataR[i] * steps) / steps;
-        }
+        SampleType steps = 4 + (1 - erosionStart) * 60; // 4 to 64 steps
+        SampleType stepsInc = (erosionStart - erosionEnd) * 60 * rampStep;
+        quantize(kernels, channelDataL, numSamples, steps, stepsInc);
+        if (channelDataR) quantize(kernels, channelDataR, numSamples, steps, stepsInc);
     }
 
     // 4. Tremor (Tremolo)
-    if (tremorVal > 0.0f)
+    float tremorStart = startValue(ModulationMatrix::destTremor);
+    float tremorEnd   = endValue(ModulationMatrix::destTremor);
+    if (tremorStart > 0.0f || tremorEnd > 0.0f)
     {
-        float rate = 0.5f + tremorVal * 10.0f; // 0.5Hz to 10.5Hz
-        float phaseInc = (float)(rate * 2.0 * juce::MathConstants<double>::pi / sampleRate);
+        // Phase kept at the chain's precision, so the double chain's LFO doesn't drift in float
+        auto& tremoloPhase = chain.tremoloPhase;
+        SampleType rate = (SampleType) 0.5 + (SampleType) tremorStart * 10; // 0.5Hz to 10.5Hz
+        SampleType rateInc = (SampleType) (tremorEnd - tremorStart) * 10 / (SampleType) numSamples;
+        const SampleType radiansPerHz = (SampleType) (juce::MathConstants<double>::twoPi / sampleRate);
+        const SampleType twoPi = juce::MathConstants<SampleType>::twoPi;
         
         for (int i = 0; i < numSamples; ++i)
         {
-            float mod = 0.5f + 0.5f * std::sin(tremoloPhase);
-            tremoloPhase += phaseInc;
-            if (tremoloPhase > 2.0f * juce::MathConstants<float>::pi) tremoloPhase -= 2.0f * juce::MathConstants<float>::pi;
+            rate += rateInc;
+            SampleType mod = (SampleType) 0.5 + (SampleType) 0.5 * std::sin(tremoloPhase);
+            tremoloPhase += rate * radiansPerHz;
+            if (tremoloPhase > twoPi) tremoloPhase -= twoPi;
             
             // Mix tremolo based on intensity? User just said "Tremolo Rate". 
             // Usually tremolo has depth too. We'll assume full depth or scale depth with rate? 
@@ -259,71 +605,163 @@ void AbyssalGazeNewAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     }
 
     // 5. Whispers (Delay)
-    // Simple feedback delay
-    if (whispersVal > 0.0f)
+    // Feedback delay over DelayMemory (up to 30s, float, double or 16-bit storage).
+    // In Granular mode the echo tap is replaced by grains scattered over the same history.
+    float whispersStart = startValue(ModulationMatrix::destWhispers);
+    float whispersEnd   = endValue(ModulationMatrix::destWhispers);
+    bool freeze = whispersFreezeParam->load() >= 0.5f; // Looper: recirculate the memory, ignore the input
+    if (whispersStart > 0.0f || whispersEnd > 0.0f || freeze)
     {
-        int delaySamples = (int)(0.5 * sampleRate); // Fixed 500ms delay time for "Whispers"
-        float feedback = whispersVal * 0.9f; // Up to 90% feedback
+        bool granular = whispersModeParam->load() >= 0.5f;
+        bool recording = ! (granular && freeze); // Frozen grains keep scattering over the frozen history
 
-        const float* delayL = delayBuffer.getReadPointer(0);
-        const float* delayR = delayBuffer.getReadPointer(1); // Assuming stereo delay buffer
-        float* delayWriteL = delayBuffer.getWritePointer(0);
-        float* delayWriteR = delayBuffer.getWritePointer(1);
-        int delayLen = delayBuffer.getNumSamples();
+        // The delay is never shorter than a segment, so each segment is one block read + one block write
+        int delaySamples = juce::jlimit(numSamples, delayMemory.getLength() - 1, (int)(whispersTimeParam->load() * sampleRate));
+        SampleType feedbackInc = (SampleType) (whispersEnd - whispersStart) * (SampleType) 0.9 * rampStep;
 
-        for (int i = 0; i < numSamples; ++i)
+        SampleType delayed[2][ModulationMatrix::maxControlInterval];
+        SampleType toMemory[ModulationMatrix::maxControlInterval];
+        int numDelayChannels = juce::jmin(totalNumOutputChannels, delayMemory.getNumChannels(), 2);
+
+        if (granular)
         {
-            int readPos = (delayWritePosition - delaySamples + delayLen) % delayLen;
-            
-            float inL = channelDataL[i];
-            float inR = channelDataR ? channelDataR[i] : inL;
+            // Grains are rendered in float
+            float grains[2][ModulationMatrix::maxControlInterval];
+            float* grainOut[2] = { grains[0], grains[1] };
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                grainOut[0] = delayed[0];
+                grainOut[1] = delayed[1];
+            }
+
+            juce::FloatVectorOperations::clear(grainOut[0], numSamples);
+            juce::FloatVectorOperations::clear(grainOut[1], numSamples);
+            grainEngine.process(delayMemory, delayWritePosition, grainOut, numDelayChannels, numSamples);
+
+            if constexpr (std::is_same_v<SampleType, double>)
+                for (int ch = 0; ch < numDelayChannels; ++ch)
+                    kernels.floatToDouble(grains[ch], delayed[ch], numSamples);
+        }
 
-            float delayedL = delayL[readPos];
-            float delayedR = delayR ? delayR[readPos] : delayedL;
+        for (int ch = 0; ch < numDelayChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer(ch, startSample);
+            SampleType feedback = (SampleType) whispersStart * (SampleType) 0.9; // Up to 90% feedback
 
-            channelDataL[i] += delayedL; // Add delay
-            if (channelDataR) channelDataR[i] += delayedR;
+            if (! granular)
+                delayMemory.read(ch, delayWritePosition - delaySamples, delayed[ch], numSamples);
 
-            delayWriteL[delayWritePosition] = inL + delayedL * feedback;
-            if (delayWriteR) delayWriteR[delayWritePosition] = inR + delayedR * feedback;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                feedback += feedbackInc;
+                toMemory[i] = freeze ? delayed[ch][i] : data[i] + delayed[ch][i] * feedback;
+                data[i] += delayed[ch][i]; // Add delay
+            }
 
-            delayWritePosition++;
-            if (delayWritePosition >= delayLen) delayWritePosition = 0;
+            if (recording)
+                delayMemory.write(ch, delayWritePosition, toMemory, numSamples);
         }
+
+        if (recording)
+            delayWritePosition = delayMemory.wrap(delayWritePosition + numSamples);
     }
 
     // 6. VOID (Reverb)
-    if (voidVal > 0.0f)
+    float voidVal = endValue(ModulationMatrix::destVoid);
+    if (voidReduced)
     {
-        reverbParams.roomSize = voidVal;
-        reverbParams.dryLevel = 0.0f; // We are inserting it, so we handle dry/wet manually or just process
-        reverbParams.wetLevel = 1.0f;
-        reverb.setParameters(reverbParams);
+        // Keep the bypass delay running so switching VOID off stays in time
+        SampleType bypass[2][ModulationMatrix::maxControlInterval];
+        SampleType* bypassChannels[2] = { bypass[0], bypass[1] };
+        const int numVoidChannels = juce::jmin(totalNumOutputChannels, 2);
+
+        for (int ch = 0; ch < numVoidChannels; ++ch)
+            juce::FloatVectorOperations::copy(bypass[ch], buffer.getReadPointer(ch, startSample), numSamples);
+
+        juce::dsp::AudioBlock<SampleType> bypassBlock(bypassChannels, (size_t) numVoidChannels, (size_t) numSamples);
+        chain.voidStage.bypassDelay.process(juce::dsp::ProcessContextReplacing<SampleType>(bypassBlock));
+
+        SampleType* voidChannels[2] = { channelDataL, channelDataR };
+
+        if (voidVal > 0.0f)
+        {
+            // Don't let the filters replay what they held when VOID was switched off
+            if (! chain.voidStage.running)
+                chain.voidStage.rateReducer.reset();
+            chain.voidStage.running = true;
+
+            if (voidVal != reverbParams.roomSize || reverbParams.wetLevel != 1.0f)
+            {
+                reverbParams.roomSize = voidVal;
+                reverbParams.dryLevel = 0.0f;
+                reverbParams.wetLevel = 1.0f;
+                chain.voidStage.reverb.setParameters(reverbParams);
+            }
+
+            chain.voidStage.rateReducer.process(voidChannels, numVoidChannels, numSamples, [&chain, numVoidChannels](SampleType* const* data, int num)
+            {
+                juce::dsp::AudioBlock<SampleType> reducedBlock(data, (size_t) numVoidChannels, (size_t) num);
+                chain.voidStage.reverb.process(juce::dsp::ProcessContextReplacing<SampleType>(reducedBlock));
+            });
+        }
+        else
+        {
+            chain.voidStage.running = false;
+            for (int ch = 0; ch < numVoidChannels; ++ch)
+                juce::FloatVectorOperations::copy(voidChannels[ch], bypass[ch], numSamples);
+        }
+    }
+    else if (voidVal > 0.0f)
+    {
+        // Only touch the reverb when the size actually moved, setParameters isn't free
+        if (voidVal != reverbParams.roomSize || reverbParams.wetLevel != 1.0f)
+        {
+            reverbParams.roomSize = voidVal;
+            reverbParams.dryLevel = 0.0f; // We are inserting it, so we handle dry/wet manually or just process
+            reverbParams.wetLevel = 1.0f;
+            chain.voidStage.reverb.setParameters(reverbParams);
+        }
         
         // Reverb expects stereo usually
-        reverb.process(context);
+        chain.voidStage.reverb.process(context);
     }
 
     // 7. Drown (Dry/Wet Mix)
-    // Mix dryBuffer with processed buffer
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
+    // Mix dryBuffer with processed buffer. Drown runs at audio rate when modulated.
+    if (voidReduced)
     {
-        auto* dry = dryBuffer.getReadPointer(ch);
-        auto* wet = buffer.getWritePointer(ch);
-        
+        auto drySegment = juce::dsp::AudioBlock<SampleType>(chain.dryBuffer).getSubBlock(0, (size_t)numSamples);
+        chain.voidStage.dryDelay.process(juce::dsp::ProcessContextReplacing<SampleType>(drySegment));
+    }
+
+    const float* drownOffsets = modMatrix.isAudioRate(ModulationMatrix::destDrown)
+                                    ? modMatrix.getAudioRateOffsets(ModulationMatrix::destDrown) : nullptr;
+    SampleType drownStart = startValue(ModulationMatrix::destDrown);
+    SampleType drownInc = (endValue(ModulationMatrix::destDrown) - drownStart) * rampStep;
+
+    SampleType drownValues[ModulationMatrix::maxControlInterval];
+    if (drownOffsets != nullptr)
+    {
+        SampleType drownBase = baseStart[ModulationMatrix::destDrown];
+        SampleType drownBaseInc = (baseEnd[ModulationMatrix::destDrown] - drownBase) * rampStep;
+
         for (int i = 0; i < numSamples; ++i)
         {
-            wet[i] = dry[i] * (1.0f - drownVal) + wet[i] * drownVal;
+            drownBase += drownBaseInc;
+            drownValues[i] = juce::jlimit((SampleType) 0, (SampleType) 1, drownBase + drownOffsets[i]);
         }
     }
 
-    // Calculate RMS for Visualizer
-    float rms = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
-    if (totalNumOutputChannels > 1)
+    for (int ch = 0; ch < totalNumInputChannels; ++ch)
     {
-        rms = juce::jmax(rms, buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+        auto* dry = chain.dryBuffer.getReadPointer(ch);
+        auto* wet = buffer.getWritePointer(ch, startSample);
+
+        if (drownOffsets != nullptr)
+            mixBuffer(kernels, wet, dry, drownValues, numSamples);
+        else
+            mixRamp(kernels, wet, dry, numSamples, drownStart, drownInc);
     }
-    currentRMS.store(rms);
 }
 
 //==============================================================================
@@ -11,6 +11,13 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ModulationMatrix.h"
+#include "DelayMemory.h"
+#include "GrainEngine.h"
+#include "SubBlockAutomation.h"
+#include "DSPKernels.h"
+#include "RateReducer.h"
+#include "VoidReverb.h"
 
 class AbyssalGazeNewAudioProcessor  : public juce::AudioProcessor, public juce::AudioProcessorValueTreeState::Listener
 {
@@ -28,6 +35,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -64,6 +73,35 @@ public:
     static const juce::String id_whispers;
     static const juce::String id_tremor;
     static const juce::String id_revelation;
+    static const juce::String id_voidReducedRate;
+
+    // Whispers IDs
+    static const juce::String id_whispersTime;
+    static const juce::String id_whispersFreeze;
+    static const juce::String id_whispersMemory;
+    static const juce::String id_whispersMode;
+    static const juce::String id_grainDensity;
+    static const juce::String id_grainSize;
+    static const juce::String id_grainPitch;
+    static const juce::String id_grainSpray;
+
+    static constexpr double maxDelaySeconds = 30.0;
+
+    // Modulation Matrix IDs
+    static const juce::String id_lfo1Rate;
+    static const juce::String id_lfo2Rate;
+    static const juce::String id_macro;
+    static const juce::String id_modRate;
+    static juce::String getModSlotID (int slot, const juce::String& field); // field: "Source", "Dest", "Depth"
+
+    // Sets the seven knobs to a Revelation preset (message thread, or the main thread of a headless host)
+    static constexpr int numPresets = 10;
+    void applyPreset (int presetIndex);
+
+    // Sample-accurate change of one of the seven knobs (ModulationMatrix::Destination order,
+    // 0-1) at sampleOffset in the next processBlock; it holds until the parameter itself changes.
+    // Used for the timestamped editor changes, and for hosts that know the offset. Audio thread only.
+    void automateParameter (int destination, int sampleOffset, float value);
 
     // Audio Metering
     std::atomic<float> currentRMS { 0.0f };
@@ -74,18 +112,111 @@ private:
     void parameterChanged (const juce::String& parameterID, float newValue) override;
 
     void updatePresets(int presetIndex);
+    void updateModulationMatrix();
+    void prepareDelayMemory();
+    void prepareVoid();
+
+    // The chain, for float and native double buffers
+    template <typename SampleType>
+    void processChain (juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType>
+    void processSegment (juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                         const float* baseStart, const float* baseEnd);
+
+    // Automation (sub-block splitting for the seven knobs)
+    SubBlockAutomation<ModulationMatrix::numDestinations> automation;
+
+    // Knob changes made on the message thread, timestamped for the next block
+    struct KnobChange
+    {
+        int destination;
+        float value;
+        juce::int64 ticks;
+    };
+    static constexpr int maxKnobChanges = SubBlockAutomation<ModulationMatrix::numDestinations>::maxEvents;
+    juce::AbstractFifo knobChangeFifo { maxKnobChanges };
+    std::array<KnobChange, maxKnobChanges> knobChanges {};
+    juce::int64 lastBlockTicks = 0;
+
+    // Modulation
+    ModulationMatrix modMatrix;
+    std::array<std::atomic<float>*, ModulationMatrix::numDestinations> destinationParams {};
+
+    struct ModSlotParams
+    {
+        std::atomic<float>* source = nullptr;
+        std::atomic<float>* destination = nullptr;
+        std::atomic<float>* depth = nullptr;
+    };
+    std::array<ModSlotParams, ModulationMatrix::numSlots> modSlotParams;
+    std::atomic<float>* lfo1RateParam = nullptr;
+    std::atomic<float>* lfo2RateParam = nullptr;
+    std::atomic<float>* macroParam = nullptr;
+    std::atomic<float>* modRateParam = nullptr;
 
     // DSP Objects
-    juce::dsp::StateVariableTPTFilter<float> filter; // Obscura
-    juce::dsp::Reverb reverb; // VOID
-    juce::dsp::Reverb::Parameters reverbParams;
+    const DSPKernels& kernels = getDSPKernels(); // SIMD kernels for this CPU
+    juce::dsp::Reverb::Parameters reverbParams; // VOID
+
+    // Per-precision state of the chain (both are prepared, the host picks one)
+    template <typename SampleType>
+    struct ChainState
+    {
+        juce::dsp::StateVariableTPTFilter<SampleType> filter; // Obscura
+
+        // VOID, at a reduced internal rate in sessions above 48kHz. The chain after VOID
+        // and the Drown dry path are delayed by the resampler latency, VOID or not.
+        // prepareVoid builds a new one off the audio thread and swaps it in.
+        struct VoidStage
+        {
+            VoidReverb<SampleType> reverb;
+            RateReducer<SampleType> rateReducer;
+            juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None> bypassDelay, dryDelay;
+            bool running = false;
+        };
+
+        VoidStage voidStage;
+
+        SampleType tremoloPhase = 0; // Tremor
+
+        // Dry copy of the current segment for the Drown mix (maxControlInterval samples, sized in prepareToPlay)
+        juce::AudioBuffer<SampleType> dryBuffer;
+    };
+
+    ChainState<float> floatChain;
+    ChainState<double> doubleChain;
+
+    template <typename SampleType>
+    ChainState<SampleType>& getChain() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleChain;
+        else
+            return floatChain;
+    }
+
+    bool voidReduced = false;
+    std::atomic<float>* voidReducedRateParam = nullptr;
     
     // Delay (Whispers)
-    juce::AudioBuffer<float> delayBuffer;
+    DelayMemory delayMemory;
     int delayWritePosition = 0;
-
-    // Tremolo (Tremor)
-    float tremoloPhase = 0.0f;
-
+    std::atomic<float>* whispersTimeParam = nullptr;
+    std::atomic<float>* whispersFreezeParam = nullptr;
+    std::atomic<float>* whispersMemoryParam = nullptr;
+    std::atomic<float>* whispersModeParam = nullptr;
+
+    // Granular Whispers
+    GrainEngine grainEngine;
+    std::atomic<float>* grainDensityParam = nullptr;
+    std::atomic<float>* grainSizeParam = nullptr;
+    std::atomic<float>* grainPitchParam = nullptr;
+    std::atomic<float>* grainSprayParam = nullptr;
+
+    // Captured by callAsync, which can run after the processor is gone. Made in the
+    // constructor so parameterChanged (possibly on the audio thread) only copies it.
+    juce::WeakReference<AbyssalGazeNewAudioProcessor> weakThis;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (AbyssalGazeNewAudioProcessor)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AbyssalGazeNewAudioProcessor)
 };
@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+
+    RateReducer.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Runs a stage at an internal rate capped near 48kHz: polyphase half-band
+// decimators (2x each) in front, the matching interpolators behind.
+// The stage's output comes back delayed by getLatencySamples(), any block
+// size up to the prepared maximum works (down to 1 sample), and nothing
+// allocates after prepare(). SampleType is float or double.
+template <typename SampleType>
+class RateReducer
+{
+public:
+    static constexpr int maxFactor = 8;
+    static constexpr double minInternalRate = 44100.0;
+    static constexpr double passbandHz = 20000.0;
+    static constexpr double stopbandDb = 80.0;
+
+    //==============================================================================
+    void prepare (double sessionRate, int numChannels, int maximumBlockSize)
+    {
+        factor = 1;
+        while (factor < maxFactor && sessionRate / (factor * 2) >= minInternalRate - 1.0)
+            factor *= 2;
+
+        internalRate = sessionRate / factor;
+        latency = 0;
+        stages.clear();
+
+        double rate = sessionRate;
+        int blockSize = maximumBlockSize;
+
+        for (int f = factor; f > 1; f /= 2)
+        {
+            stages.emplace_back();
+            auto& stage = stages.back();
+            stage.design (rate);
+            stage.prepare (juce::jmin (numChannels, 2), blockSize / 2 + 1);
+
+            // Decimator + interpolator delay, in session samples
+            latency += 2 * stage.centre * (int) (sessionRate / rate);
+
+            rate *= 0.5;
+            blockSize = blockSize / 2 + 1;
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+            stage.reset();
+    }
+
+    int getFactor() const noexcept            { return factor; }
+    double getInternalRate() const noexcept   { return internalRate; }
+    int getLatencySamples() const noexcept    { return latency; }
+
+    //==============================================================================
+    // Decimates data, calls processReduced (SampleType* const* data, int numSamples) on
+    // the internal-rate samples (in place) and interpolates the result back into data.
+    template <typename ProcessFunction>
+    void process (SampleType* const* data, int numChannels, int numSamples, ProcessFunction&& processReduced)
+    {
+        processStage (0, data, numChannels, numSamples, processReduced);
+    }
+
+private:
+    //==============================================================================
+    // One 2x half-band stage, in polyphase form. Apart from the centre tap (0.5) only
+    // taps at odd offsets from the centre are non-zero, and they all land on the odd
+    // input phase; mirrored taps share one multiply. The filters run tap by tap over
+    // the whole block so the inner loops are plain vector loops.
+    struct Stage
+    {
+        void design (double inputRate)
+        {
+            // Transition band centred on the output Nyquist, wide enough to keep passbandHz
+            auto transition = (0.5 * inputRate - 2.0 * passbandHz) / inputRate;
+            auto length = (int) std::ceil ((stopbandDb - 7.95) / (14.36 * transition)) + 1;
+            centre = ((length - 1) / 2) | 1;
+
+            const int windowSize = 2 * centre + 1;
+            std::vector<double> window ((size_t) windowSize);
+            juce::dsp::WindowingFunction<double>::fillWindowingTables (window.data(), (size_t) windowSize,
+                                                                       juce::dsp::WindowingFunction<double>::kaiser,
+                                                                       false, 0.1102 * (stopbandDb - 8.7));
+
+            // taps[i] = h[2i] = h[2 * centre - 2i]
+            taps.resize ((size_t) (centre + 1) / 2);
+            double sum = 0.0;
+
+            for (size_t i = 0; i < taps.size(); ++i)
+            {
+                auto x = juce::MathConstants<double>::pi * (double) (2 * (int) i - centre) * 0.5;
+                taps[i] = (SampleType) (0.5 * std::sin (x) / x * window[i * 2]);
+                sum += 2.0 * taps[i];
+            }
+
+            // Unity gain at DC
+            for (auto& t : taps)
+                t = (SampleType) (t * 0.5 / sum);
+        }
+
+        void prepare (int numChannels, int maximumLowSamples)
+        {
+            maxLow = maximumLowSamples;
+            channels.resize ((size_t) numChannels);
+
+            for (auto& c : channels)
+            {
+                c.odd.assign ((size_t) (centre + maxLow), (SampleType) 0);
+                c.even.assign ((size_t) (centreDelay() + 1 + maxLow), (SampleType) 0);
+                c.low.assign ((size_t) (centre + maxLow), (SampleType) 0);
+            }
+
+            scratchOdd.assign ((size_t) maxLow, (SampleType) 0);
+            scratchEven.assign ((size_t) maxLow, (SampleType) 0);
+        }
+
+        void reset()
+        {
+            for (auto& c : channels)
+            {
+                std::fill (c.odd.begin(), c.odd.end(), (SampleType) 0);
+                std::fill (c.even.begin(), c.even.end(), (SampleType) 0);
+                std::fill (c.low.begin(), c.low.end(), (SampleType) 0);
+                c.evenAhead = false;
+
+                // The interpolator runs one sample ahead of the decimator, prime it
+                c.pending = 0;
+                c.hasPending = true;
+            }
+        }
+
+        int centreDelay() const noexcept { return (centre - 1) / 2; }
+
+        // Splits input into the two phases and returns the number of low-rate samples
+        // now waiting in the channel's low buffer (after its history).
+        int decimate (int channel, const SampleType* input, int numSamples) noexcept
+        {
+            auto& c = channels[(size_t) channel];
+            const int evenHistory = centreDelay() + (c.evenAhead ? 1 : 0);
+            int numOdd = 0, numEven = 0;
+
+            for (int n = 0; n < numSamples; ++n)
+            {
+                if (c.evenAhead)
+                    c.odd[(size_t) (centre + numOdd++)] = input[n];
+                else
+                    c.even[(size_t) (evenHistory + numEven++)] = input[n];
+
+                c.evenAhead = ! c.evenAhead;
+            }
+
+            // y[m] = 0.5 * even[m - centreDelay] + sum taps[i] * (odd[m - i] + odd[m - centre + i])
+            SampleType* out = c.low.data() + centre;
+            const SampleType* odd = c.odd.data();
+            const SampleType* even = c.even.data();
+
+            for (int m = 0; m < numOdd; ++m)
+                out[m] = (SampleType) 0.5 * even[m];
+
+            for (size_t i = 0; i < taps.size(); ++i)
+            {
+                const SampleType tap = taps[i];
+                const SampleType* newer = odd + centre - (int) i;
+                const SampleType* older = odd + (int) i;
+
+                for (int m = 0; m < numOdd; ++m)
+                    out[m] += tap * (newer[m] + older[m]);
+            }
+
+            // Keep the histories for the next block
+            std::memmove (c.odd.data(), c.odd.data() + numOdd, (size_t) centre * sizeof (SampleType));
+            std::memmove (c.even.data(), c.even.data() + numOdd,
+                          (size_t) (evenHistory + numEven - numOdd) * sizeof (SampleType));
+
+            return numOdd;
+        }
+
+        SampleType* getLowSamples (int channel) noexcept
+        {
+            return channels[(size_t) channel].low.data() + centre;
+        }
+
+        // Writes exactly numSamples: two per low-rate sample, plus / minus the pending one
+        void interpolate (int channel, int numLow, SampleType* output, int numSamples) noexcept
+        {
+            auto& c = channels[(size_t) channel];
+            const SampleType* low = c.low.data();
+
+            // z[2m + 1] = 2 * sum taps[i] * (y[m - i] + y[m - centre + i]),  z[2m + 2] = y[m - centreDelay]
+            SampleType* odd = scratchOdd.data();
+            juce::FloatVectorOperations::clear (odd, numLow);
+
+            for (size_t i = 0; i < taps.size(); ++i)
+            {
+                const SampleType tap = (SampleType) 2 * taps[i];
+                const SampleType* newer = low + centre - (int) i;
+                const SampleType* older = low + (int) i;
+
+                for (int m = 0; m < numLow; ++m)
+                    odd[m] += tap * (newer[m] + older[m]);
+            }
+
+            juce::FloatVectorOperations::copy (scratchEven.data(), low + centre - centreDelay(), numLow);
+
+            int written = 0;
+            if (c.hasPending)
+            {
+                output[written++] = c.pending;
+                c.hasPending = false;
+            }
+
+            for (int m = 0; m < numLow; ++m)
+            {
+                output[written++] = scratchOdd[(size_t) m];
+
+                if (written < numSamples)
+                    output[written++] = scratchEven[(size_t) m];
+                else
+                    { c.pending = scratchEven[(size_t) m]; c.hasPending = true; }
+            }
+
+            jassert (written == numSamples);
+            std::memmove (c.low.data(), c.low.data() + numLow, (size_t) centre * sizeof (SampleType));
+        }
+
+        struct Channel
+        {
+            std::vector<SampleType> odd, even, low; // histories followed by the current block
+            bool evenAhead = false;                 // the last input landed on the even phase
+            SampleType pending = 0;
+            bool hasPending = true;
+        };
+
+        std::vector<SampleType> taps;
+        int centre = 1; // group delay at the stage's input rate (odd)
+        int maxLow = 0;
+        std::vector<Channel> channels;
+        std::vector<SampleType> scratchOdd, scratchEven;
+    };
+
+    //==============================================================================
+    template <typename ProcessFunction>
+    void processStage (size_t index, SampleType* const* data, int numChannels, int numSamples, ProcessFunction& processReduced)
+    {
+        if (index == stages.size())
+        {
+            processReduced (data, numSamples);
+            return;
+        }
+
+        auto& stage = stages[index];
+        SampleType* low[2] = { nullptr, nullptr };
+        int numLow = 0;
+
+        numChannels = juce::jmin (numChannels, (int) stage.channels.size());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            numLow = stage.decimate (ch, data[ch], numSamples);
+            low[ch] = stage.getLowSamples (ch);
+        }
+
+        if (numLow > 0)
+            processStage (index + 1, low, numChannels, numLow, processReduced);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            stage.interpolate (ch, numLow, data[ch], numSamples);
+    }
+
+    std::vector<Stage> stages;
+    int factor = 1;
+    double internalRate = 44100.0;
+    int latency = 0;
+};
@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    RenderMain.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    Headless render of every Revelation preset through the real processor.
+    Used as the PGO training run (see CMakeLists.txt) and as a quick
+    whole-chain speed check, in float, in native double and in double the
+    way a 64-bit host runs a float-only plugin (convert in and out per block).
+    Also nulls each preset's float render against its native double render.
+
+    Usage: AbyssalGazeRender [--seconds 20] [--rate 48000] [--block 512] [--out <dir>]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <cstdio>
+
+namespace
+{
+    enum class Path { singlePrecision, nativeDouble, hostConversion, numPaths };
+    const char* pathNames[] = { "float", "double", "converted" };
+
+    // Deterministic test signal: decaying saw notes over a bed of noise bursts
+    void fillTestSignal (juce::AudioBuffer<double>& buffer, juce::int64 startSample, double sampleRate, juce::Random& random)
+    {
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            auto t = (double) (startSample + i) / sampleRate;
+            auto noteTime = std::fmod (t, 0.75);
+            auto note = (int) (t / 0.75) % 5;
+            auto frequency = 55.0 * std::pow (2.0, (double) (note * 7 % 12) / 12.0);
+            auto saw = (float) (2.0 * std::fmod (t * frequency, 1.0) - 1.0);
+            auto envelope = (float) std::exp (-noteTime * 4.0);
+            auto burst = std::fmod (t, 2.0) < 0.05 ? random.nextFloat() * 2.0f - 1.0f : 0.0f;
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.setSample (ch, i, (double) (0.5f * saw * envelope + 0.3f * burst));
+        }
+    }
+
+    void setParameter (AbyssalGazeNewAudioProcessor& processor, const juce::String& id, float value)
+    {
+        if (auto* param = processor.apvts.getParameter (id))
+            param->setValueNotifyingHost (param->convertTo0to1 (value));
+    }
+
+    // Returns the realtime factor of the render, the audio goes to output
+    double renderPreset (int presetIndex, bool granular, Path path, double sampleRate, int blockSize, double seconds,
+                         const juce::File& outputDir, juce::AudioBuffer<double>& output)
+    {
+        const bool useDouble = path == Path::nativeDouble;
+
+        AbyssalGazeNewAudioProcessor processor;
+        processor.applyPreset (presetIndex);
+
+        // Second pass per preset covers the paths the presets leave off
+        if (granular)
+        {
+            setParameter (processor, AbyssalGazeNewAudioProcessor::id_whispersMode, 1.0f);
+            setParameter (processor, AbyssalGazeNewAudioProcessor::id_whispersMemory, 1.0f);
+            setParameter (processor, AbyssalGazeNewAudioProcessor::id_grainDensity, 200.0f);
+            setParameter (processor, AbyssalGazeNewAudioProcessor::getModSlotID (0, "Source"), 1.0f);
+            setParameter (processor, AbyssalGazeNewAudioProcessor::getModSlotID (0, "Dest"), 1.0f);
+            setParameter (processor, AbyssalGazeNewAudioProcessor::getModSlotID (0, "Depth"), 0.3f);
+        }
+
+        processor.setProcessingPrecision (useDouble ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails (sampleRate, blockSize);
+        processor.prepareToPlay (sampleRate, blockSize);
+
+        const auto totalSamples = (juce::int64) (seconds * sampleRate);
+        const int numChannels = processor.getTotalNumOutputChannels();
+        // Signal and output are kept in double for every path; converted is the same audio as float, so it isn't written
+        const bool writeOutput = outputDir.isDirectory() && path != Path::hostConversion;
+        juce::AudioBuffer<double> block (numChannels, blockSize);
+        juce::AudioBuffer<float> floatBlock (numChannels, blockSize);
+        output.setSize (numChannels, (int) totalSamples);
+        juce::MidiBuffer midi;
+        juce::Random random (presetIndex + 1);
+
+        double processSeconds = 0.0;
+
+        for (juce::int64 pos = 0; pos < totalSamples; pos += blockSize)
+        {
+            auto num = (int) juce::jmin ((juce::int64) blockSize, totalSamples - pos);
+            block.setSize (numChannels, num, false, false, true);
+            floatBlock.setSize (numChannels, num, false, false, true);
+            fillTestSignal (block, pos, sampleRate, random);
+
+            // The float path starts from float input, like a 32-bit host
+            if (path == Path::singlePrecision)
+                floatBlock.makeCopyOf (block, true);
+
+            auto start = juce::Time::getHighResolutionTicks();
+
+            if (path == Path::nativeDouble)
+            {
+                processor.processBlock (block, midi);
+            }
+            else if (path == Path::hostConversion)
+            {
+                floatBlock.makeCopyOf (block, true);
+                processor.processBlock (floatBlock, midi);
+                block.makeCopyOf (floatBlock, true);
+            }
+            else
+            {
+                processor.processBlock (floatBlock, midi);
+            }
+
+            processSeconds += juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+
+            if (path == Path::singlePrecision)
+                block.makeCopyOf (floatBlock, true);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                output.copyFrom (ch, (int) pos, block, ch, 0, num);
+        }
+
+        processor.releaseResources();
+
+        if (writeOutput)
+        {
+            auto file = outputDir.getChildFile (juce::String::formatted ("preset%02d%s%s.wav", presetIndex + 1, granular ? "_granular" : "",
+                                                                         useDouble ? "_double" : ""));
+            file.deleteFile();
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer (wav.createWriterFor (new juce::FileOutputStream (file),
+                                                                                  sampleRate, (unsigned int) numChannels, 24, {}, 0));
+            juce::AudioBuffer<float> floatOutput;
+            floatOutput.makeCopyOf (output);
+
+            if (writer != nullptr)
+                writer->writeFromAudioSampleBuffer (floatOutput, 0, floatOutput.getNumSamples());
+        }
+
+        return seconds / juce::jmax (1.0e-9, processSeconds);
+    }
+
+    // Largest sample difference between two renders, in dBFS
+    double getNullDecibels (const juce::AudioBuffer<double>& a, const juce::AudioBuffer<double>& b)
+    {
+        double maxDifference = 0.0;
+
+        for (int ch = 0; ch < juce::jmin (a.getNumChannels(), b.getNumChannels()); ++ch)
+            for (int i = 0; i < juce::jmin (a.getNumSamples(), b.getNumSamples()); ++i)
+                maxDifference = juce::jmax (maxDifference, std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+        return juce::Decibels::gainToDecibels (maxDifference, -400.0);
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args (argc, argv);
+    auto seconds    = args.containsOption ("--seconds") ? args.getValueForOption ("--seconds").getDoubleValue() : 20.0;
+    auto sampleRate = args.containsOption ("--rate")    ? args.getValueForOption ("--rate").getDoubleValue()    : 48000.0;
+    auto blockSize  = args.containsOption ("--block")   ? args.getValueForOption ("--block").getIntValue()      : 512;
+    auto outputDir  = args.containsOption ("--out")     ? args.getExistingFolderForOption ("--out")              : juce::File();
+
+    std::printf ("Rendering %d presets, %.0fs @ %.0fHz, block %d, kernels: %s\n",
+                 AbyssalGazeNewAudioProcessor::numPresets, seconds, sampleRate, blockSize, getDSPKernels().name);
+
+    std::printf ("%-20s", "Realtime factor");
+    for (auto* name : pathNames)
+        std::printf (" %10s", name);
+    std::printf (" %16s\n", "float-double dB");
+
+    juce::AudioBuffer<double> renders[(size_t) Path::numPaths];
+
+    for (int preset = 0; preset < AbyssalGazeNewAudioProcessor::numPresets; ++preset)
+    {
+        for (auto granular : { false, true })
+        {
+            std::printf ("Preset %2d %-9s ", preset + 1, granular ? "granular" : "");
+
+            for (int path = 0; path < (int) Path::numPaths; ++path)
+                std::printf (" %9.1fx", renderPreset (preset, granular, (Path) path, sampleRate, blockSize, seconds,
+                                                      outputDir, renders[path]));
+
+            // Grains are scheduled from an unseeded generator, so granular renders never null
+            if (granular)
+                std::printf (" %16s\n", "-");
+            else
+                std::printf (" %16.1f\n", getNullDecibels (renders[(int) Path::singlePrecision], renders[(int) Path::nativeDouble]));
+        }
+    }
+
+    return 0;
+}
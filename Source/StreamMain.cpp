@@ -0,0 +1,543 @@
+/*
+  ==============================================================================
+
+    StreamMain.cpp
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+    Headless streaming host: interleaved raw PCM in on stdin, processed PCM
+    out on stdout, for live pipelines without a DAW, e.g.
+
+      ffmpeg -i in.flac -f f32le -ac 2 -ar 48000 - \
+        | AbyssalGazeStream --rate 48000 --preset 4 --set whispersTime=1.5 \
+        | ffmpeg -f f32le -ac 2 -ar 48000 -i - out.flac
+
+    The I/O thread reads block k+1 while the main thread processes block k,
+    then writes block k: two slots, each de-interleaved straight into the
+    buffer processBlock runs on. Stats go to stderr.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <mutex>
+
+#if JUCE_WINDOWS
+ #include <fcntl.h>
+ #include <io.h>
+#endif
+
+namespace
+{
+    //==============================================================================
+    enum class SampleFormat { float32, int16, int24, int32 };
+
+    int getBytesPerSample (SampleFormat format)
+    {
+        switch (format)
+        {
+            case SampleFormat::int16: return 2;
+            case SampleFormat::int24: return 3;
+            default:                  return 4;
+        }
+    }
+
+    using FloatSamples = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian,
+                                                  juce::AudioData::NonInterleaved, juce::AudioData::NonConst>;
+
+    template <typename SampleType>
+    void deinterleave (const void* raw, float* const* dest, int numChannels, int numFrames)
+    {
+        using RawSamples = juce::AudioData::Pointer<SampleType, juce::AudioData::LittleEndian,
+                                                    juce::AudioData::Interleaved, juce::AudioData::Const>;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            FloatSamples (dest[ch]).convertSamples (RawSamples (static_cast<const char*> (raw) + ch * SampleType::bytesPerSample, numChannels), numFrames);
+    }
+
+    template <typename SampleType>
+    void interleave (const float* const* src, void* raw, int numChannels, int numFrames)
+    {
+        using RawSamples = juce::AudioData::Pointer<SampleType, juce::AudioData::LittleEndian,
+                                                    juce::AudioData::Interleaved, juce::AudioData::NonConst>;
+        using ConstFloatSamples = juce::AudioData::Pointer<juce::AudioData::Float32, juce::AudioData::NativeEndian,
+                                                           juce::AudioData::NonInterleaved, juce::AudioData::Const>;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            RawSamples (static_cast<char*> (raw) + ch * SampleType::bytesPerSample, numChannels).convertSamples (ConstFloatSamples (src[ch]), numFrames);
+    }
+
+    // Raw PCM <-> the float channels processBlock runs on, in one pass (no staging copy)
+    void rawToFloat (SampleFormat format, const void* raw, float* const* dest, int numChannels, int numFrames)
+    {
+        switch (format)
+        {
+            case SampleFormat::float32: deinterleave<juce::AudioData::Float32> (raw, dest, numChannels, numFrames); break;
+            case SampleFormat::int16:   deinterleave<juce::AudioData::Int16>   (raw, dest, numChannels, numFrames); break;
+            case SampleFormat::int24:   deinterleave<juce::AudioData::Int24>   (raw, dest, numChannels, numFrames); break;
+            case SampleFormat::int32:   deinterleave<juce::AudioData::Int32>   (raw, dest, numChannels, numFrames); break;
+        }
+    }
+
+    void floatToRaw (SampleFormat format, const float* const* src, void* raw, int numChannels, int numFrames)
+    {
+        switch (format)
+        {
+            case SampleFormat::float32: interleave<juce::AudioData::Float32> (src, raw, numChannels, numFrames); break;
+            case SampleFormat::int16:   interleave<juce::AudioData::Int16>   (src, raw, numChannels, numFrames); break;
+            case SampleFormat::int24:   interleave<juce::AudioData::Int24>   (src, raw, numChannels, numFrames); break;
+            case SampleFormat::int32:   interleave<juce::AudioData::Int32>   (src, raw, numChannels, numFrames); break;
+        }
+    }
+
+    //==============================================================================
+    // Reads up to numBytes, retrying short reads from the pipe. Returns the bytes read (< numBytes at EOF).
+    size_t readFully (void* dest, size_t numBytes)
+    {
+        size_t total = 0;
+
+        while (total < numBytes)
+        {
+            auto n = std::fread (static_cast<char*> (dest) + total, 1, numBytes - total, stdin);
+            if (n == 0)
+                break;
+            total += n;
+        }
+
+        return total;
+    }
+
+    //==============================================================================
+    // One half of the double buffer: the raw block as read / to be written, and
+    // the de-interleaved float channels processBlock runs on.
+    struct Slot
+    {
+        enum State { empty, filled, processed };
+
+        juce::HeapBlock<char> raw;
+        juce::AudioBuffer<float> audio;
+        int numFrames = 0;       // valid frames (the last block may be short)
+        bool last = false;
+        State state = empty;
+    };
+
+    struct Settings
+    {
+        double sampleRate = 48000.0;
+        int numChannels = 2;
+        int blockSize = 256;
+        SampleFormat format = SampleFormat::float32;
+        bool trimLatency = false;
+        double statsInterval = 0.0;
+    };
+
+    //==============================================================================
+    // Owns stdin / stdout. Reads block k + 1 into one slot while the main thread
+    // processes block k in the other, then writes block k out.
+    class StreamIOThread : public juce::Thread
+    {
+    public:
+        StreamIOThread (const Settings& s, Slot (&slotsToUse)[2], int latencyToTrim)
+            : juce::Thread ("Abyssal Gaze Stream I/O"), settings (s), slots (slotsToUse), framesToTrim (latencyToTrim)
+        {
+        }
+
+        // Main thread: waits for the next filled slot, nullptr when the stream is over
+        Slot* waitForInput (int index)
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            condition.wait (lock, [&] { return slots[index].state == Slot::filled || finished; });
+            return slots[index].state == Slot::filled ? &slots[index] : nullptr;
+        }
+
+        void markProcessed (Slot& slot)
+        {
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                slot.state = Slot::processed;
+            }
+            condition.notify_all();
+        }
+
+        juce::int64 getFramesRead() const noexcept     { return framesRead; }
+        juce::int64 getFramesWritten() const noexcept  { return framesWritten; }
+
+        void run() override
+        {
+            const int frameBytes = settings.numChannels * getBytesPerSample (settings.format);
+            juce::int64 flushFrames = settings.trimLatency ? framesToTrim : 0;
+            bool inputDone = false;
+
+            for (int k = 0; ! threadShouldExit(); ++k)
+            {
+                auto& slot = slots[k % 2];
+
+                if (! inputDone)
+                {
+                    waitForState (slot, Slot::empty);
+                    inputDone = ! fill (slot, frameBytes, flushFrames);
+
+                    {
+                        std::lock_guard<std::mutex> lock (mutex);
+                        slot.state = Slot::filled;
+                    }
+                    condition.notify_all();
+                }
+
+                // Write out the previous block while this one is being processed
+                if (k > 0)
+                {
+                    auto& previous = slots[(k - 1) % 2];
+                    waitForState (previous, Slot::processed);
+                    if (! drain (previous, frameBytes))
+                        break;
+
+                    auto wasLast = previous.last;
+                    {
+                        std::lock_guard<std::mutex> lock (mutex);
+                        previous.state = Slot::empty;
+                    }
+                    condition.notify_all();
+
+                    if (wasLast)
+                        break;
+                }
+            }
+
+            std::fflush (stdout);
+
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                finished = true;
+            }
+            condition.notify_all();
+        }
+
+    private:
+        void waitForState (Slot& slot, Slot::State state)
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            condition.wait (lock, [&] { return slot.state == state; });
+        }
+
+        // Returns false once stdin is exhausted (the slot is then the last one)
+        bool fill (Slot& slot, int frameBytes, juce::int64& flushFrames)
+        {
+            const int blockSize = settings.blockSize;
+            int frames = 0;
+
+            if (! eof)
+            {
+                auto bytes = readFully (slot.raw.getData(), (size_t) (blockSize * frameBytes));
+                frames = (int) (bytes / (size_t) frameBytes);
+                eof = bytes < (size_t) (blockSize * frameBytes);
+            }
+
+            framesRead += frames;
+
+            // After EOF keep feeding silence until the latency-delayed tail is out
+            auto flush = (int) juce::jmin ((juce::int64) (blockSize - frames), flushFrames);
+            if (eof)
+                flushFrames -= flush;
+
+            std::memset (slot.raw.getData() + (size_t) frames * (size_t) frameBytes, 0,
+                         (size_t) (blockSize - frames) * (size_t) frameBytes);
+
+            rawToFloat (settings.format, slot.raw.getData(), slot.audio.getArrayOfWritePointers(), settings.numChannels, blockSize);
+
+            slot.numFrames = eof ? frames + flush : blockSize;
+            slot.last = eof && flushFrames == 0;
+            return ! slot.last;
+        }
+
+        bool drain (Slot& slot, int frameBytes)
+        {
+            floatToRaw (settings.format, slot.audio.getArrayOfReadPointers(), slot.raw.getData(), settings.numChannels, slot.numFrames);
+
+            // Drop the first latency frames so the output lines up with the input
+            auto skip = (int) juce::jmin ((juce::int64) slot.numFrames, framesToTrim);
+            if (settings.trimLatency)
+                framesToTrim -= skip;
+            else
+                skip = 0;
+
+            auto numBytes = (size_t) (slot.numFrames - skip) * (size_t) frameBytes;
+            if (numBytes > 0 && std::fwrite (slot.raw.getData() + (size_t) skip * (size_t) frameBytes, 1, numBytes, stdout) != numBytes)
+                return false; // downstream closed
+
+            std::fflush (stdout);
+            framesWritten += slot.numFrames - skip;
+            return true;
+        }
+
+        const Settings& settings;
+        Slot (&slots)[2];
+        juce::int64 framesToTrim;
+        std::atomic<juce::int64> framesRead { 0 }, framesWritten { 0 };
+        bool eof = false, finished = false;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    //==============================================================================
+    struct BlockStats
+    {
+        juce::int64 numBlocks = 0, numOverruns = 0;
+        double totalSeconds = 0.0, maxSeconds = 0.0;
+
+        void add (double seconds, double deadline)
+        {
+            ++numBlocks;
+            totalSeconds += seconds;
+            maxSeconds = juce::jmax (maxSeconds, seconds);
+            numOverruns += seconds > deadline ? 1 : 0;
+        }
+    };
+
+    void printStats (const char* label, const BlockStats& stats, const Settings& settings, double wallSeconds, juce::int64 frames)
+    {
+        auto blockSeconds = settings.blockSize / settings.sampleRate;
+        auto audioSeconds = (double) frames / settings.sampleRate;
+        auto averageSeconds = stats.totalSeconds / (double) juce::jmax ((juce::int64) 1, stats.numBlocks);
+
+        std::fprintf (stderr, "[%s] %.1fs audio in %.1fs | DSP %.1fx realtime | block avg %.3fms max %.3fms (budget %.3fms, %lld over)\n",
+                      label, audioSeconds, wallSeconds, audioSeconds / juce::jmax (1.0e-9, stats.totalSeconds),
+                      averageSeconds * 1000.0, stats.maxSeconds * 1000.0, blockSeconds * 1000.0, (long long) stats.numOverruns);
+    }
+
+    //==============================================================================
+    void printUsage()
+    {
+        std::fprintf (stderr,
+            "Usage: AbyssalGazeStream [options] < in.raw > out.raw\n"
+            "  --rate <hz>           sample rate (48000)\n"
+            "  --channels <1|2>      interleaved channels (2)\n"
+            "  --block <frames>      processing block size (256)\n"
+            "  --format <f32|s16|s24|s32>  little-endian sample format (f32)\n"
+            "  --preset <1-10>       start from a Revelation preset\n"
+            "  --state <file>        load a state (plugin state chunk or its XML)\n"
+            "  --set <id>=<value>    set a parameter in its own units, repeatable\n"
+            "                        (revelation=<name> loads the preset's knobs, like --preset)\n"
+            "  --trim-latency        drop the plugin latency at the start, flush the tail at the end\n"
+            "  --stats <seconds>     also print stats every few seconds\n"
+            "  --list-params         print the parameter IDs and ranges\n");
+    }
+
+    bool parseFormat (const juce::String& text, SampleFormat& format)
+    {
+        if (text == "f32") { format = SampleFormat::float32; return true; }
+        if (text == "s16") { format = SampleFormat::int16;   return true; }
+        if (text == "s24") { format = SampleFormat::int24;   return true; }
+        if (text == "s32") { format = SampleFormat::int32;   return true; }
+        return false;
+    }
+
+    bool loadState (AbyssalGazeNewAudioProcessor& processor, const juce::File& file)
+    {
+        juce::MemoryBlock data;
+        if (! file.loadFileAsData (data) || data.getSize() == 0)
+            return false;
+
+        // Hand-written XML, or the binary chunk getStateInformation produces
+        if (auto xml = juce::parseXML (data.toString()))
+        {
+            if (! xml->hasTagName (processor.apvts.state.getType()))
+                return false;
+
+            processor.apvts.replaceState (juce::ValueTree::fromXml (*xml));
+            return true;
+        }
+
+        processor.setStateInformation (data.getData(), (int) data.getSize());
+        return true;
+    }
+
+    bool setParameter (AbyssalGazeNewAudioProcessor& processor, const juce::String& assignment)
+    {
+        auto id = assignment.upToFirstOccurrenceOf ("=", false, false).trim();
+        auto value = assignment.fromFirstOccurrenceOf ("=", false, false).trim();
+
+        auto* param = dynamic_cast<juce::RangedAudioParameter*> (processor.apvts.getParameter (id));
+        if (param == nullptr || value.isEmpty())
+            return false;
+
+        // Choices and bools also take their text ("Granular", "On")
+        auto normalised = value.containsOnly ("0123456789.-+eE") ? param->convertTo0to1 (value.getFloatValue())
+                                                                 : param->getValueForText (value);
+        normalised = juce::jlimit (0.0f, 1.0f, normalised);
+
+        // Revelation loads its preset through callAsync, and nothing runs the message loop here
+        if (id == AbyssalGazeNewAudioProcessor::id_revelation)
+        {
+            processor.applyPreset (juce::roundToInt (param->convertFrom0to1 (normalised)));
+            return true;
+        }
+
+        param->setValueNotifyingHost (normalised);
+        return true;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args (argc, argv);
+
+   #if ! JUCE_WINDOWS
+    // A reader that goes away should end the stream through the failed write, not kill us
+    std::signal (SIGPIPE, SIG_IGN);
+   #endif
+
+    if (args.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    Settings settings;
+    if (args.containsOption ("--rate"))      settings.sampleRate = args.getValueForOption ("--rate").getDoubleValue();
+    if (args.containsOption ("--channels"))  settings.numChannels = args.getValueForOption ("--channels").getIntValue();
+    if (args.containsOption ("--block"))     settings.blockSize = args.getValueForOption ("--block").getIntValue();
+    if (args.containsOption ("--stats"))     settings.statsInterval = args.getValueForOption ("--stats").getDoubleValue();
+    settings.trimLatency = args.containsOption ("--trim-latency");
+
+    if (args.containsOption ("--format") && ! parseFormat (args.getValueForOption ("--format"), settings.format))
+    {
+        std::fprintf (stderr, "Unknown --format '%s'\n", args.getValueForOption ("--format").toRawUTF8());
+        return 1;
+    }
+
+    if (settings.sampleRate < 8000.0 || settings.numChannels < 1 || settings.numChannels > 2 || settings.blockSize < 1)
+    {
+        printUsage();
+        return 1;
+    }
+
+    AbyssalGazeNewAudioProcessor processor;
+
+    if (args.containsOption ("--list-params"))
+    {
+        for (auto* p : processor.getParameters())
+            if (auto* param = dynamic_cast<juce::RangedAudioParameter*> (p))
+                std::fprintf (stderr, "%-16s %-22s %s .. %s (default %s)\n", param->getParameterID().toRawUTF8(), param->getName (64).toRawUTF8(),
+                              param->getText (0.0f, 32).toRawUTF8(), param->getText (1.0f, 32).toRawUTF8(),
+                              param->getText (param->getDefaultValue(), 32).toRawUTF8());
+        return 0;
+    }
+
+    // Parameters are all in place before prepareToPlay, which sets up the memory / VOID from them
+    if (args.containsOption ("--state"))
+    {
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--state"));
+        if (! loadState (processor, file))
+        {
+            std::fprintf (stderr, "Could not load state from %s\n", file.getFullPathName().toRawUTF8());
+            return 1;
+        }
+    }
+
+    if (args.containsOption ("--preset"))
+        processor.applyPreset (args.getValueForOption ("--preset").getIntValue() - 1);
+
+    for (int i = 0; i + 1 < args.size(); ++i)
+    {
+        if (args[i] == "--set" && ! setParameter (processor, args[i + 1].text))
+        {
+            std::fprintf (stderr, "Bad --set '%s' (see --list-params)\n", args[i + 1].text.toRawUTF8());
+            return 1;
+        }
+    }
+
+    juce::AudioProcessor::BusesLayout layout;
+    auto channelSet = settings.numChannels == 1 ? juce::AudioChannelSet::mono() : juce::AudioChannelSet::stereo();
+    layout.inputBuses.add (channelSet);
+    layout.outputBuses.add (channelSet);
+    processor.setBusesLayout (layout);
+
+    processor.setRateAndBufferSizeDetails (settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay (settings.sampleRate, settings.blockSize);
+
+    const int latency = processor.getLatencySamples();
+    const int frameBytes = settings.numChannels * getBytesPerSample (settings.format);
+
+    Slot slots[2];
+    for (auto& slot : slots)
+    {
+        slot.raw.allocate ((size_t) (settings.blockSize * frameBytes), true);
+        slot.audio.setSize (settings.numChannels, settings.blockSize);
+    }
+
+    std::fprintf (stderr, "Abyssal Gaze stream: %.0fHz, %d ch, block %d, kernels %s\n",
+                  settings.sampleRate, settings.numChannels, settings.blockSize, getDSPKernels().name);
+    std::fprintf (stderr, "Latency: %d (block) + %d (double buffer) + %d (plugin%s) = %d frames, %.2fms\n",
+                  settings.blockSize, settings.blockSize, latency, settings.trimLatency ? ", trimmed" : "",
+                  2 * settings.blockSize + latency, (2 * settings.blockSize + latency) * 1000.0 / settings.sampleRate);
+
+    // Binary PCM on the standard streams, buffered one block at a time
+   #if JUCE_WINDOWS
+    _setmode (_fileno (stdin), _O_BINARY);
+    _setmode (_fileno (stdout), _O_BINARY);
+   #endif
+    std::setvbuf (stdin, nullptr, _IOFBF, (size_t) (settings.blockSize * frameBytes));
+    std::setvbuf (stdout, nullptr, _IOFBF, (size_t) (settings.blockSize * frameBytes));
+
+    StreamIOThread io (settings, slots, latency);
+    io.startThread (juce::Thread::Priority::high);
+
+    juce::MidiBuffer midi;
+    BlockStats stats, intervalStats;
+    const double deadline = settings.blockSize / settings.sampleRate;
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    auto lastReportTicks = startTicks;
+
+    for (int k = 0;; ++k)
+    {
+        auto* slot = io.waitForInput (k % 2);
+        if (slot == nullptr)
+            break;
+
+        // processBlock runs on the slot's own channels, nothing is copied
+        auto blockStart = juce::Time::getHighResolutionTicks();
+        processor.processBlock (slot->audio, midi);
+        auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - blockStart);
+
+        stats.add (seconds, deadline);
+        intervalStats.add (seconds, deadline);
+
+        auto last = slot->last;
+        io.markProcessed (*slot);
+
+        if (settings.statsInterval > 0.0)
+        {
+            auto now = juce::Time::getHighResolutionTicks();
+            if (juce::Time::highResolutionTicksToSeconds (now - lastReportTicks) >= settings.statsInterval)
+            {
+                printStats ("interval", intervalStats, settings, juce::Time::highResolutionTicksToSeconds (now - startTicks), io.getFramesRead());
+                intervalStats = {};
+                lastReportTicks = now;
+            }
+        }
+
+        if (last)
+            break;
+    }
+
+    io.stopThread (-1);
+    processor.releaseResources();
+
+    auto wallSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+    printStats ("total", stats, settings, wallSeconds, io.getFramesRead());
+    std::fprintf (stderr, "Throughput: %.0f frames/s (%.1fx realtime), %lld frames in, %lld out\n",
+                  (double) io.getFramesRead() / juce::jmax (1.0e-9, wallSeconds),
+                  (double) io.getFramesRead() / settings.sampleRate / juce::jmax (1.0e-9, wallSeconds),
+                  (long long) io.getFramesRead(), (long long) io.getFramesWritten());
+
+    return 0;
+}
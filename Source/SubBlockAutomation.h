@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    SubBlockAutomation.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Sample-accurate parameter automation for a fixed set of parameters.
+// processBlock splits the block into sub-blocks at the change points and asks
+// for the value of every parameter at each sub-block boundary.
+//
+// Two kinds of change are handled:
+//  - Timed events (addEvent) land on their sample offset, or on the previous
+//    change point when that is less than minSubBlockLength before it, so dense
+//    automation can't cut the block into tiny sub-blocks. The next block ramps
+//    from the last event's value to the host value, which for a timestamped
+//    editor change is the same value; a stale event just gives way to it.
+//  - A value that only changed between blocks (what the JUCE wrappers hand us:
+//    the last host value of the block) is ramped linearly over the whole
+//    block, so the result no longer depends on the host buffer size.
+template <int NumParameters>
+class SubBlockAutomation
+{
+public:
+    static constexpr int maxEvents = 256;
+    static constexpr int minSubBlockLength = 8;
+
+    //==============================================================================
+    void reset (const float* currentValues) noexcept
+    {
+        std::copy (currentValues, currentValues + NumParameters, lastValues.begin());
+        targetValues = lastValues;
+        numEvents = 0;
+    }
+
+    // Schedules a change at sampleOffset within the next block. Call from the
+    // audio thread before processBlock; events beyond maxEvents are dropped.
+    void addEvent (int sampleOffset, int parameterIndex, float value) noexcept
+    {
+        if (numEvents < maxEvents)
+            events[(size_t) numEvents++] = { sampleOffset, parameterIndex, value };
+    }
+
+    //==============================================================================
+    void beginBlock (const float* newTargetValues, int newNumSamples) noexcept
+    {
+        numSamples = newNumSamples;
+        std::copy (newTargetValues, newTargetValues + NumParameters, targetValues.begin());
+
+        // Few events per block: insertion sort keeps same-offset events in order
+        for (int i = 1; i < numEvents; ++i)
+            for (int j = i; j > 0 && events[(size_t) j].sampleOffset < events[(size_t) j - 1].sampleOffset; --j)
+                std::swap (events[(size_t) j], events[(size_t) j - 1]);
+
+        hasEvents.fill (false);
+        int lastChangePoint = 0;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto& e = events[(size_t) i];
+            e.sampleOffset = juce::jlimit (0, juce::jmax (0, numSamples - 1), e.sampleOffset);
+
+            if (e.sampleOffset - lastChangePoint < minSubBlockLength)
+                e.sampleOffset = lastChangePoint;
+            else
+                lastChangePoint = e.sampleOffset;
+
+            if (juce::isPositiveAndBelow (e.parameterIndex, NumParameters))
+                hasEvents[(size_t) e.parameterIndex] = true;
+        }
+    }
+
+    // End (exclusive) of the sub-block starting at start: the next change point,
+    // capped at start + maxLength. Only the block's last sub-block can be shorter
+    // than minSubBlockLength.
+    int getSubBlockEnd (int start, int maxLength) const noexcept
+    {
+        auto end = juce::jmin (start + maxLength, numSamples);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            auto offset = events[(size_t) i].sampleOffset;
+
+            if (offset > start && offset < end)
+                return offset;
+
+            // Cut earlier rather than leave a sliver before the change point
+            if (offset > end && offset < end + minSubBlockLength)
+                return offset - minSubBlockLength >= start + minSubBlockLength ? offset - minSubBlockLength : end;
+        }
+
+        return end;
+    }
+
+    // Value of every parameter at sampleOffset. Timed events step the value
+    // (events exactly at sampleOffset count for a sub-block start, not for an end);
+    // parameters without events ramp from the previous block's value to this block's.
+    void getValues (int sampleOffset, bool includeEventsAtOffset, float* dest) const noexcept
+    {
+        auto proportion = numSamples > 0 ? (float) sampleOffset / (float) numSamples : 1.0f;
+
+        for (int p = 0; p < NumParameters; ++p)
+            dest[p] = hasEvents[(size_t) p] ? lastValues[(size_t) p]
+                                            : lastValues[(size_t) p] + (targetValues[(size_t) p] - lastValues[(size_t) p]) * proportion;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const auto& e = events[(size_t) i];
+
+            if (e.sampleOffset < sampleOffset || (includeEventsAtOffset && e.sampleOffset == sampleOffset))
+                if (juce::isPositiveAndBelow (e.parameterIndex, NumParameters))
+                    dest[e.parameterIndex] = e.value;
+        }
+    }
+
+    void endBlock() noexcept
+    {
+        // Events at the end count too, so a zero-length block doesn't lose them
+        getValues (numSamples, true, lastValues.data());
+        numEvents = 0;
+    }
+
+private:
+    struct Event
+    {
+        int sampleOffset;
+        int parameterIndex;
+        float value;
+    };
+
+    std::array<float, NumParameters> lastValues {}, targetValues {};
+    std::array<bool, NumParameters> hasEvents {};
+    std::array<Event, maxEvents> events {};
+    int numEvents = 0;
+    int numSamples = 0;
+};
@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    VoidReverb.h
+    Created: 19 Oct 2026
+    Author:  Antigravity
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The VOID reverb: juce::Reverb's Freeverb network (same tunings, parameters and
+// smoothing), templated on the sample type so the double-precision chain keeps
+// its combs and tail in double. Denormals are left to the processor's
+// ScopedNoDenormals. Drop-in for juce::dsp::Reverb with a replacing context.
+template <typename SampleType>
+class VoidReverb
+{
+public:
+    using Parameters = juce::Reverb::Parameters;
+
+    //==============================================================================
+    VoidReverb()
+    {
+        setParameters ({});
+    }
+
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        static const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 }; // (at 44100Hz)
+        static const short allPassTunings[] = { 556, 441, 341, 225 };
+        const int stereoSpread = 23;
+        const int intSampleRate = (int) spec.sampleRate;
+
+        for (int i = 0; i < numCombs; ++i)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                comb[ch][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread * ch)) / 44100);
+        }
+
+        for (int i = 0; i < numAllPasses; ++i)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                allPass[ch][i].setSize ((intSampleRate * (allPassTunings[i] + stereoSpread * ch)) / 44100);
+        }
+
+        const double smoothTime = 0.01;
+        damping .reset (spec.sampleRate, smoothTime);
+        feedback.reset (spec.sampleRate, smoothTime);
+        dryGain .reset (spec.sampleRate, smoothTime);
+        wetGain1.reset (spec.sampleRate, smoothTime);
+        wetGain2.reset (spec.sampleRate, smoothTime);
+
+        reset();
+    }
+
+    void reset()
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (auto& c : comb[ch])
+                c.clear();
+
+            for (auto& a : allPass[ch])
+                a.clear();
+        }
+    }
+
+    const Parameters& getParameters() const noexcept { return parameters; }
+
+    void setParameters (const Parameters& newParams)
+    {
+        const SampleType wetScaleFactor = 3;
+        const SampleType dryScaleFactor = 2;
+
+        const auto wet = (SampleType) newParams.wetLevel * wetScaleFactor;
+        dryGain .setTargetValue ((SampleType) newParams.dryLevel * dryScaleFactor);
+        wetGain1.setTargetValue ((SampleType) 0.5 * wet * ((SampleType) 1 + (SampleType) newParams.width));
+        wetGain2.setTargetValue ((SampleType) 0.5 * wet * ((SampleType) 1 - (SampleType) newParams.width));
+
+        gain = isFrozen (newParams.freezeMode) ? (SampleType) 0 : (SampleType) 0.015;
+        parameters = newParams;
+        updateDamping();
+    }
+
+    //==============================================================================
+    void process (const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+    {
+        auto& block = context.getOutputBlock();
+        const auto numSamples = (int) block.getNumSamples();
+
+        if (context.isBypassed)
+            return;
+
+        if (block.getNumChannels() == 1)
+            processMono (block.getChannelPointer (0), numSamples);
+        else if (block.getNumChannels() == 2)
+            processStereo (block.getChannelPointer (0), block.getChannelPointer (1), numSamples);
+        else
+            jassertfalse; // mono or stereo only
+    }
+
+    void processStereo (SampleType* left, SampleType* right, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto input = (left[i] + right[i]) * gain;
+            const auto dampingToUse = damping.getNextValue();
+            const auto feedbackToUse = feedback.getNextValue();
+            SampleType outL = 0, outR = 0;
+
+            for (int j = 0; j < numCombs; ++j) // accumulate the comb filters in parallel
+            {
+                outL += comb[0][j].process (input, dampingToUse, feedbackToUse);
+                outR += comb[1][j].process (input, dampingToUse, feedbackToUse);
+            }
+
+            for (int j = 0; j < numAllPasses; ++j) // run the allpass filters in series
+            {
+                outL = allPass[0][j].process (outL);
+                outR = allPass[1][j].process (outR);
+            }
+
+            const auto dry  = dryGain.getNextValue();
+            const auto wet1 = wetGain1.getNextValue();
+            const auto wet2 = wetGain2.getNextValue();
+
+            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+        }
+    }
+
+    void processMono (SampleType* samples, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto input = samples[i] * gain;
+            const auto dampingToUse = damping.getNextValue();
+            const auto feedbackToUse = feedback.getNextValue();
+            SampleType output = 0;
+
+            for (int j = 0; j < numCombs; ++j)
+                output += comb[0][j].process (input, dampingToUse, feedbackToUse);
+
+            for (int j = 0; j < numAllPasses; ++j)
+                output = allPass[0][j].process (output);
+
+            const auto dry  = dryGain.getNextValue();
+            const auto wet1 = wetGain1.getNextValue();
+
+            samples[i] = output * wet1 + samples[i] * dry;
+        }
+    }
+
+private:
+    //==============================================================================
+    static bool isFrozen (float freezeMode) noexcept  { return freezeMode >= 0.5f; }
+
+    void updateDamping() noexcept
+    {
+        const SampleType roomScaleFactor = (SampleType) 0.28;
+        const SampleType roomOffset = (SampleType) 0.7;
+        const SampleType dampScaleFactor = (SampleType) 0.4;
+
+        if (isFrozen (parameters.freezeMode))
+            setDamping (0, 1);
+        else
+            setDamping ((SampleType) parameters.damping * dampScaleFactor,
+                        (SampleType) parameters.roomSize * roomScaleFactor + roomOffset);
+    }
+
+    void setDamping (SampleType dampingToUse, SampleType roomSizeToUse) noexcept
+    {
+        damping.setTargetValue (dampingToUse);
+        feedback.setTargetValue (roomSizeToUse);
+    }
+
+    //==============================================================================
+    class CombFilter
+    {
+    public:
+        void setSize (int size)
+        {
+            if ((size_t) size != buffer.size())
+            {
+                buffer.assign ((size_t) juce::jmax (1, size), (SampleType) 0);
+                bufferIndex = 0;
+            }
+        }
+
+        void clear() noexcept
+        {
+            last = 0;
+            std::fill (buffer.begin(), buffer.end(), (SampleType) 0);
+        }
+
+        SampleType process (SampleType input, SampleType dampingToUse, SampleType feedbackLevel) noexcept
+        {
+            const auto output = buffer[(size_t) bufferIndex];
+            last = (output * ((SampleType) 1 - dampingToUse)) + (last * dampingToUse);
+            buffer[(size_t) bufferIndex] = input + (last * feedbackLevel);
+
+            if (++bufferIndex >= (int) buffer.size())
+                bufferIndex = 0;
+
+            return output;
+        }
+
+    private:
+        std::vector<SampleType> buffer;
+        int bufferIndex = 0;
+        SampleType last = 0;
+    };
+
+    class AllPassFilter
+    {
+    public:
+        void setSize (int size)
+        {
+            if ((size_t) size != buffer.size())
+            {
+                buffer.assign ((size_t) juce::jmax (1, size), (SampleType) 0);
+                bufferIndex = 0;
+            }
+        }
+
+        void clear() noexcept
+        {
+            std::fill (buffer.begin(), buffer.end(), (SampleType) 0);
+        }
+
+        SampleType process (SampleType input) noexcept
+        {
+            const auto bufferedValue = buffer[(size_t) bufferIndex];
+            buffer[(size_t) bufferIndex] = input + (bufferedValue * (SampleType) 0.5);
+
+            if (++bufferIndex >= (int) buffer.size())
+                bufferIndex = 0;
+
+            return bufferedValue - input;
+        }
+
+    private:
+        std::vector<SampleType> buffer;
+        int bufferIndex = 0;
+    };
+
+    //==============================================================================
+    static constexpr int numChannels = 2, numCombs = 8, numAllPasses = 4;
+
+    Parameters parameters;
+    SampleType gain = 0;
+
+    std::array<CombFilter, numCombs> comb[numChannels];
+    std::array<AllPassFilter, numAllPasses> allPass[numChannels];
+
+    juce::SmoothedValue<SampleType> damping, feedback, dryGain, wetGain1, wetGain2;
+};